@@ -28,6 +28,8 @@
 #ifndef __ABSTRACTCONTROLLER_H_
 #define __ABSTRACTCONTROLLER_H_
 
+#include <SFML/System.hpp>
+
 class AbstractController {
 public:
     enum _keys {
@@ -47,6 +49,18 @@ public:
         KEY_7,
         KEY_8,
         KEY_9,
+        KEY_HIGHLIGHT,
+        KEY_NEXT_EMPTY,
+        KEY_NEXT_FEWEST,
+        KEY_SEEK_1,
+        KEY_SEEK_2,
+        KEY_SEEK_3,
+        KEY_SEEK_4,
+        KEY_SEEK_5,
+        KEY_SEEK_6,
+        KEY_SEEK_7,
+        KEY_SEEK_8,
+        KEY_SEEK_9,
     };
 
     ///
@@ -56,6 +70,19 @@ public:
     ///
     virtual void processKeypressEvent(enum _keys key) = 0;
 
+    ///
+    /// \brief Process the keypress events, with the time the key was pressed
+    ///
+    /// The controllers that don't need the time only implement 
+    /// processKeypressEvent().
+    ///
+    /// \param key       The key that is pressed
+    /// \param timestamp The time the key was pressed (see inputqueue.h)
+    ///
+    virtual void processInputEvent(enum _keys key, sf::Time timestamp) {
+        processKeypressEvent(key);
+    }
+
     ///
     /// \brief The controller's destructor
     ///
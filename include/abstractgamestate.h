@@ -33,6 +33,34 @@
 
 class AbstractGameState : public AbstractController, public AbstractViewer {
 public:
+    ///
+    /// \brief Create the resources that have to be created in the game 
+    ///        loop's thread (e.g. shaders and render textures)
+    ///
+    /// Called when the game state is pushed, so the game state's constructor
+    /// can be run in a worker thread. It may be called more than once.
+    ///
+    virtual void loadGraphics() { }
+
+    ///
+    /// \brief Get the pool where the game state is kept to be reused, once 
+    ///        it's removed from the stack (see gamestatepool.h)
+    ///
+    /// \return The pool name, or NULL to delete the game state instead
+    ///
+    virtual const char *poolName() const { return NULL; }
+
+    ///
+    /// \brief Check whether the game state is drawn over the game state 
+    ///        below it (e.g. a pause menu)
+    ///
+    /// The game state below is frozen into a texture when the overlay is 
+    /// pushed, see GameManager_frozenFrame().
+    ///
+    /// \return true if the game state is an overlay
+    ///
+    virtual bool isOverlay() const { return false; }
+
     ///
     /// \brief The AbstractGameState desctructor
     ///
@@ -0,0 +1,69 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Interface to execute the draw commands that are recorded by the sprite 
+ * batch. The backend decides what "drawing" means: a real render target, 
+ * counting only, or saving the commands.
+ */
+
+#ifndef __ABSTRACTRENDERBACKEND_H_
+#define __ABSTRACTRENDERBACKEND_H_
+
+#include <SFML/Graphics.hpp>
+
+class AbstractRenderBackend {
+public:
+    ///
+    /// \brief Execute a single draw command
+    ///
+    /// \param vertex      The quads' vertex (4 vertex for each quad)
+    /// \param vertexCount The no of vertex
+    /// \param texture     The quads' texture, or NULL for untextured quads
+    /// \param shader      The quads' shader, or NULL for the fixed pipeline
+    /// \param transform   The transform applied to the vertex
+    ///
+    virtual void drawQuads(const sf::Vertex    *vertex, 
+                           unsigned int         vertexCount,
+                           const sf::Texture   *texture,
+                           const sf::Shader    *shader,
+                           const sf::Transform &transform) = 0;
+
+    ///
+    /// \brief Replace the pixels of a texture. It's executed before the 
+    ///        draw commands that follow it. The backends that don't draw 
+    ///        ignore it.
+    ///
+    /// \param texture The texture
+    /// \param pixels  The new pixels (RGBA), for the texture's whole size
+    ///
+    virtual void updateTexture(sf::Texture     *texture, 
+                               const sf::Uint8 *pixels) { }
+
+    ///
+    /// \brief The backend's destructor
+    ///
+    virtual ~AbstractRenderBackend() { }
+};
+
+#endif // __ABSTRACTRENDERBACKEND_H_
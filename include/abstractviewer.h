@@ -29,9 +29,22 @@
 #define __ABSTRACTVIEWER_H_
 
 #include <SFML/Graphics.hpp>
+#include "spritebatch.h"
+#include "dirtyregion.h"
+
+///
+/// \brief The time to the next update of a view that only changes on input
+///
+#define VIEWER_NO_PENDING_UPDATE    sf::microseconds(-1)
 
 class AbstractViewer {
 public:
+    explicit AbstractViewer() :
+        _isShowed(false),
+        _layer(SPRITE_LAYER_TILE)
+    {
+    }
+
     ///
     /// \brief Update the graphic, based on the time elapsed 
     ///
@@ -42,22 +55,70 @@ public:
     ///
     /// \brief Draw the game state
     ///
-    /// \param win The handler to the window
+    /// \param batch The sprite batch to submit the quads into
+    ///
+    virtual void draw(SpriteBatch *batch) = 0;
+
+    ///
+    /// \brief Set the position between the last and the next update, for 
+    ///        the views that animate smoothly between the updates
+    ///
+    /// The update() is called in fixed time steps, which doesn't match the 
+    /// frame rate. This is called before every draw().
+    ///
+    /// \param alpha The fraction of the update step that has elapsed since 
+    ///              the last update (0 to 1)
     ///
-    virtual void draw(sf::RenderWindow *win) = 0;
+    virtual void interpolate(float alpha) { }
+
+    ///
+    /// \brief Get the time until the view has to be updated, even if there's
+    ///        no input
+    ///
+    /// \return sf::Time::Zero if the view is animating, or 
+    ///         VIEWER_NO_PENDING_UPDATE if it only changes on input
+    ///
+    virtual sf::Time timeToNextUpdate() {
+        return VIEWER_NO_PENDING_UPDATE;
+    }
 
     ///
     /// \brief Show the view
     ///
     void show() {
-        _isShowed = true;
+        if (!_isShowed) {
+            _isShowed = true;
+            DirtyRegion_invalidateAll();
+        }
     }
 
     ///
     /// \brief Hide the view
     ///
     void hide() {
-        _isShowed = false;
+        if (_isShowed) {
+            _isShowed = false;
+            DirtyRegion_invalidateAll();
+        }
+    }
+
+    ///
+    /// \brief Set the layer where the view is drawn
+    ///
+    /// \param layer The drawing layer
+    ///
+    void setLayer(int layer) {
+        _layer = layer;
+    }
+
+    ///
+    /// \brief Set the transform that's applied to the view when it's drawn
+    ///
+    /// \param transform The transform from the view's vertex to the screen
+    ///
+    void setTransform(const sf::Transform &transform) {
+        _transform = transform;
+        DirtyRegion_invalidateAll();
     }
 
     ///
@@ -72,6 +133,16 @@ protected:
     /// This flag should be polled in the draw() or update() method
     ///
     bool _isShowed;
+
+    ///
+    /// \brief The drawing layer of this view
+    ///
+    int _layer;
+
+    ///
+    /// \brief The transform from the view's vertex to the screen
+    ///
+    sf::Transform _transform;
 };
 
 #endif // __VIEWABLEINTERFACE_H_
@@ -0,0 +1,59 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Load the game artwork in the background. The images are decoded by the 
+ * job system's workers, then packed into the texture atlas, and uploaded a 
+ * few images per frame in the game loop's thread.
+ */
+
+#ifndef __ASSETLOADER_H_
+#define __ASSETLOADER_H_
+
+#include <string>
+#include <vector>
+
+///
+/// \brief Start decoding the images in the background
+///
+/// \param filenames The image file names
+///
+void AssetLoader_start(const std::vector<std::string> &filenames);
+
+///
+/// \brief Continue loading: pack the atlas when all of the images have been
+///        decoded, then upload the next images into it. Called by the game 
+///        loop on every frame.
+///
+/// \return true if all of the images have been loaded
+///
+bool AssetLoader_update();
+
+///
+/// \brief Check whether all of the images have been loaded
+///
+/// \return true if all of the images are ready to be used
+///
+bool AssetLoader_isFinished();
+
+#endif // __ASSETLOADER_H_
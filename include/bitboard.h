@@ -0,0 +1,178 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Fixed size set of board tiles, stored as one bit per tile. The set keeps
+ * track of its population, so the number of tiles in the set is known 
+ * without scanning the words. Searching the set uses the processor's bit scan
+ * instruction, so empty words are skipped 32 tiles at a time.
+ */
+
+#ifndef __BITBOARD_H_
+#define __BITBOARD_H_
+
+#include <vector>
+
+#ifdef _MSC_VER          /* MS Visual Studio specific (including express 
+                          * edition) 
+                          */
+#include <intrin.h>
+#endif
+
+class Bitboard {
+public:
+    ///
+    /// \brief Create an empty bitboard
+    ///
+    /// \param size The number of tiles that can be stored in the bitboard
+    ///
+    explicit Bitboard(unsigned int size = 0);
+
+    ///
+    /// \brief Add the tile into the set
+    ///
+    /// \param index The tile index (row * columnSize + column)
+    ///
+    void set(unsigned int index) {
+        unsigned int bit = (1u << (index % BITBOARD_WORD_BITS));
+
+        if ((_words[index / BITBOARD_WORD_BITS] & bit) == 0) {
+            _words[index / BITBOARD_WORD_BITS] |= bit;
+            _count++;
+        }
+    }
+
+    ///
+    /// \brief Remove the tile from the set
+    ///
+    /// \param index The tile index (row * columnSize + column)
+    ///
+    void reset(unsigned int index) {
+        unsigned int bit = (1u << (index % BITBOARD_WORD_BITS));
+
+        if ((_words[index / BITBOARD_WORD_BITS] & bit) != 0) {
+            _words[index / BITBOARD_WORD_BITS] &= ~bit;
+            _count--;
+        }
+    }
+
+    ///
+    /// \brief Check whether the tile is in the set
+    ///
+    /// \param index The tile index (row * columnSize + column)
+    ///
+    /// \return true if the tile is in the set
+    ///
+    bool test(unsigned int index) const {
+        return ((_words[index / BITBOARD_WORD_BITS] & 
+                 (1u << (index % BITBOARD_WORD_BITS))) != 0);
+    }
+
+    ///
+    /// \brief Get the number of tiles in the set
+    ///
+    /// \return The number of tiles in the set
+    ///
+    unsigned int count() const {
+        return _count;
+    }
+
+    ///
+    /// \brief Get the number of tiles that can be stored in the set
+    ///
+    /// \return The bitboard size
+    ///
+    unsigned int size() const {
+        return _size;
+    }
+
+    ///
+    /// \brief Remove all tiles from the set
+    ///
+    void clear();
+
+    ///
+    /// \brief Find the next tile in the set
+    ///
+    /// The search starts from the given tile, and rolls over to the first 
+    /// tile when it reaches the end of the board.
+    ///
+    /// \param from The tile index where the search starts
+    ///
+    /// \return The tile index, or -1 if the set is empty
+    ///
+    int findNext(unsigned int from) const;
+
+    ///
+    /// \brief Get the position of the lowest bit that's set in the word
+    ///
+    /// \param word The word to be scanned (must not be 0)
+    ///
+    /// \return The position of the lowest bit
+    ///
+    static unsigned int lowestBit(unsigned int word) {
+#ifdef _MSC_VER
+        unsigned long position;
+        _BitScanForward(&position, word);
+        return (unsigned int) position;
+#else
+        return (unsigned int) __builtin_ctz(word);
+#endif
+    }
+
+    ///
+    /// \brief Count the bits that are set in the word
+    ///
+    /// \param word The word to be counted
+    ///
+    /// \return The number of bits set
+    ///
+    static unsigned int bitCount(unsigned int word) {
+        word = word - ((word >> 1) & 0x55555555);
+        word = (word & 0x33333333) + ((word >> 2) & 0x33333333);
+        return (((word + (word >> 4)) & 0x0F0F0F0F) * 0x01010101) >> 24;
+    }
+
+private:
+    ///
+    /// \brief The number of bits in each word
+    ///
+    enum { BITBOARD_WORD_BITS = 32 };
+
+    ///
+    /// \brief The bits, one bit per tile
+    ///
+    std::vector<unsigned int> _words;
+
+    ///
+    /// \brief The number of tiles that can be stored
+    ///
+    unsigned int _size;
+
+    ///
+    /// \brief The number of tiles in the set
+    ///
+    unsigned int _count;
+};
+
+#endif // __BITBOARD_H_
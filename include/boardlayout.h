@@ -68,6 +68,17 @@ public:
     ///
     virtual sf::Vector2f tilePositionInScreen(int row, int column);
 
+    ///
+    /// \brief Get the transform from the tile positions to the screen
+    ///
+    /// The views apply this transform when they draw the tiles, so a board 
+    /// that's larger than the drawable screen can be scaled down without 
+    /// regenerating its vertex.
+    ///
+    /// \return The transform (identity for the default layout)
+    ///
+    virtual sf::Transform screenTransform();
+
     ///
     /// \brief Read the tile size 
     ///
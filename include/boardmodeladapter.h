@@ -80,6 +80,24 @@ public:
     ///
     void disableMask();
 
+    ///
+    /// \brief Notify the adapter that the model has been changed directly, 
+    ///        without using setValue()
+    ///
+    void markChanged();
+
+    ///
+    /// \brief Get the model version
+    ///
+    /// The version is increased everytime the model is changed, so the views
+    /// can skip the update when nothing has changed. Enabling / disabling the
+    /// mask doesn't change the version, since the views that share the 
+    /// adapter always read it with the same mask setting.
+    ///
+    /// \return The model version
+    ///
+    unsigned int version();
+
     //-------------------------------------------------------------------------
     // These functions are needed to interface the board view with the model
 
@@ -120,6 +138,29 @@ public:
     ///
     unsigned int value(int row, int column);
 
+    ///
+    /// \brief Get the tile value at row / column, ignoring the mask
+    ///
+    /// Check whether the tile is within the board before issuing this query
+    ///
+    /// \param row    The row where the tile lies
+    /// \param column The column where the tile lies
+    ///
+    /// \return the tile value in the model
+    ///
+    unsigned int unmaskedValue(int row, int column);
+
+    ///
+    /// \brief Check whether the tile is covered by the mask, whether the mask
+    ///        is enabled or not
+    ///
+    /// \param row    The row where the tile lies
+    /// \param column The column where the tile lies
+    ///
+    /// \return true if the tile is masked
+    ///
+    bool tileIsMasked(int row, int column);
+
     ///
     /// \brief Set the tile value at row / column
     ///
@@ -187,6 +228,11 @@ private:
     /// \brief Flag to indicate whether the mask is enabled / disabled
     ///
     bool _maskIsEnabled;
+
+    ///
+    /// \brief The model version, increased on every change
+    ///
+    unsigned int _version;
 };
 
 #endif // __BOARDMODELADAPTER_H_
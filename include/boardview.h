@@ -23,6 +23,9 @@
 
 /*
  * Store the board's view information (its graphic properties)
+ *
+ * The tiles' vertex are only regenerated when the board model reports a 
+ * change, and only for the tiles whose face or position has changed.
  */
 
 #ifndef __BOARDVIEW_H_
@@ -32,6 +35,7 @@
 #include "boardmodeladapter.h"
 #include "boardlayout.h"
 #include "tileview.h"
+#include "texturecache.h"
 
 class BoardView : public AbstractViewer {
 public:
@@ -51,7 +55,7 @@ public:
     //-------------------------------------------------------------------------
     // Override the AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
 
     ///
     /// \brief Virtual destructor so this class can be overridden
@@ -67,7 +71,7 @@ private:
     ///
     /// \brief The tile texture for the board
     ///
-    sf::Texture _tileTexture;
+    SharedTexture _tileTexture;
 
     ///
     /// \brief The board tiles
@@ -75,9 +79,26 @@ private:
     std::vector<TileView> _boardTiles;
     
     ///
-    /// \brief The tiles' vertex to draw
+    /// \brief The tiles' vertex to draw. Tile n's vertex are stored starting 
+    ///        at (n * 4)
     ///
     std::vector<sf::Vertex> _vertex;
+
+    ///
+    /// \brief The no of vertex to draw (the board may be smaller than the 
+    ///        no of tiles)
+    ///
+    unsigned int _vertexCount;
+
+    ///
+    /// \brief The board model version that's currently displayed
+    ///
+    unsigned int _boardVersion;
+
+    ///
+    /// \brief Flag to indicate that some tiles may need to be regenerated
+    ///
+    bool _tilesAreDirty;
 };
 
 #endif // __BOARDVIEW_H_
@@ -0,0 +1,91 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Render backend that saves the commands as text, one line per command:
+ *
+ *   quads <texture id> <shader id> <a> <b> <c> <d> <tx> <ty> <vertex count> 
+ *         (<x> <y> <r> <g> <b> <a> <u> <v>) * vertex count
+ *
+ * where (a b tx / c d ty) is the 2D transform applied to the vertex.
+ *
+ * The texture id is 0 for untextured quads, and numbered from 1 in the order
+ * the textures are first used. The shader id is numbered the same way, 0 
+ * means no shader.
+ */
+
+#ifndef __CAPTURERENDERBACKEND_H_
+#define __CAPTURERENDERBACKEND_H_
+
+#include <map>
+#include <ostream>
+#include "abstractrenderbackend.h"
+
+class CaptureRenderBackend : public AbstractRenderBackend {
+public:
+    ///
+    /// \brief Create the backend to save the commands into the stream
+    ///
+    /// \param stream The output stream
+    ///
+    explicit CaptureRenderBackend(std::ostream *stream = NULL);
+
+    //-------------------------------------------------------------------------
+    // Override the AbstractRenderBackend's methods
+    virtual void drawQuads(const sf::Vertex    *vertex, 
+                           unsigned int         vertexCount,
+                           const sf::Texture   *texture,
+                           const sf::Shader    *shader,
+                           const sf::Transform &transform);
+
+private:
+    ///
+    /// \brief Get the resource id, assign a new one if it's not known yet
+    ///
+    /// \param resource The texture / shader
+    /// \param ids      The ids that have been assigned
+    ///
+    /// \return The resource id
+    ///
+    static unsigned int resourceId(
+        const void                           *resource,
+        std::map<const void *, unsigned int> *ids
+    );
+
+    ///
+    /// \brief The output stream
+    ///
+    std::ostream *_stream;
+
+    ///
+    /// \brief The id that has been assigned to each texture
+    ///
+    std::map<const void *, unsigned int> _textureIds;
+
+    ///
+    /// \brief The id that has been assigned to each shader
+    ///
+    std::map<const void *, unsigned int> _shaderIds;
+};
+
+#endif // __CAPTURERENDERBACKEND_H_
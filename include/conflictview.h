@@ -0,0 +1,106 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Highlight the tiles whose digit is in conflict with its peers. Each tile
+ * has its own quad in the vertex array, and the quads are only regenerated
+ * when the candidate grid reports a change.
+ */
+
+#ifndef __CONFLICTVIEW_H_
+#define __CONFLICTVIEW_H_
+
+#include <vector>
+#include "abstractviewer.h"
+#include "boardlayout.h"
+#include "sudokucandidategrid.h"
+
+class ConflictView : public AbstractViewer {
+public:
+    ///
+    /// \brief The conflict's view constructor
+    ///
+    /// \param grid           The candidate grid, which tracks the conflicts
+    /// \param layout         The board's layout
+    /// \param highlightColor The color to highlight the conflicting tiles
+    ///
+    explicit ConflictView(const SudokuCandidateGrid *grid   = NULL,
+                          BoardLayout               *layout = NULL,
+                          sf::Color highlightColor = sf::Color(255, 0, 0, 96)
+    );
+
+    //-------------------------------------------------------------------------
+    // Override the AbstractViewer's methods
+    virtual void update(sf::Time elapsedTime);
+    virtual void draw(SpriteBatch *batch);
+
+    ///
+    /// \brief Virtual destructor so this class can be overridden
+    ///
+    virtual ~ConflictView() { }
+
+private:
+    ///
+    /// \brief Regenerate the highlight's vertex of a single tile
+    ///
+    /// \param tile The tile index (row * boardSize + column)
+    ///
+    void updateTileHighlight(unsigned int tile);
+
+    ///
+    /// \brief The candidate grid
+    ///
+    const SudokuCandidateGrid *_grid;
+
+    ///
+    /// \brief The highlight color
+    ///
+    sf::Color _highlightColor;
+
+    ///
+    /// \brief The tile size (in pixel)
+    ///
+    sf::Vector2u _tileSize;
+
+    ///
+    /// \brief The center position of each tile in the screen
+    ///
+    std::vector<sf::Vector2f> _tilePosition;
+
+    ///
+    /// \brief The conflict state that's currently displayed for each tile
+    ///
+    std::vector<bool> _tileInConflict;
+
+    ///
+    /// \brief The candidate grid version that's currently displayed
+    ///
+    unsigned int _gridVersion;
+
+    ///
+    /// \brief The highlights' vertex to draw (4 vertex for each tile)
+    ///
+    std::vector<sf::Vertex> _vertex;
+};
+
+#endif // __CONFLICTVIEW_H_
@@ -67,6 +67,14 @@ public:
     ///
     void resetCursorPosition();
 
+    ///
+    /// \brief Move the cursor directly into the tile in row, column
+    ///
+    /// \param row    The row of the tile
+    /// \param column The column of the tile
+    ///
+    void moveCursorTo(int row, int column);
+
 private:
     ///
     /// \brief Move the cursor up into the valid tile position
@@ -30,6 +30,7 @@
 
 #include "abstractviewer.h"
 #include "tileview.h"
+#include "texturecache.h"
 
 class CursorView : public AbstractViewer {
 public:
@@ -45,7 +46,7 @@ public:
     //-------------------------------------------------------------------------
     // Override the AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
 
     ///
     /// \brief Set the cursor's position in the screen
@@ -57,7 +58,7 @@ private:
     ///
     /// \brief The tile texture for the board
     ///
-    sf::Texture _cursorTexture;
+    SharedTexture _cursorTexture;
 
     ///
     /// \brief The cursor representatives
@@ -65,9 +66,9 @@ private:
     TileView _cursorTile;
 
     ///
-    /// \brief The tiles' vertex to draw
+    /// \brief The cursor's vertex (a single quad) to draw
     ///
-    std::vector<sf::Vertex> _vertex;
+    sf::Vertex _vertex[4];
 };
 
 #endif // __CURSORVIEW_H_
@@ -0,0 +1,80 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Track the screen regions that have changed since the last frame. The views
+ * report the regions they have changed, so the game manager only needs to 
+ * redraw those regions. The regions can be reported from any thread.
+ */
+
+#ifndef __DIRTYREGION_H_
+#define __DIRTYREGION_H_
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+///
+/// \brief Mark the screen region as changed
+///
+/// \param rect The changed region in the screen
+///
+void DirtyRegion_add(const sf::FloatRect &rect);
+
+///
+/// \brief Mark the screen region that's covered by the quad as changed
+///
+/// \param quad      The quad's 4 vertex
+/// \param transform The transform from the quad to the screen
+///
+void DirtyRegion_addQuad(const sf::Vertex    *quad,
+                         const sf::Transform &transform = 
+                             sf::Transform::Identity);
+
+///
+/// \brief Mark the whole screen as changed
+///
+void DirtyRegion_invalidateAll();
+
+///
+/// \brief Check whether the whole screen has to be redrawn
+///
+/// \return true if the whole screen has changed
+///
+bool DirtyRegion_isAllDirty();
+
+///
+/// \brief Get the changed regions, and forget them (they are going to be 
+///        redrawn). Overlapping regions are merged.
+///
+/// \param rects The changed regions (not including the whole screen flag)
+///
+/// \return true if the whole screen has to be redrawn
+///
+bool DirtyRegion_take(std::vector<sf::IntRect> *rects);
+
+///
+/// \brief Forget all the changed regions (after they have been redrawn)
+///
+void DirtyRegion_clear();
+
+#endif // __DIRTYREGION_H_
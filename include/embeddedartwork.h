@@ -0,0 +1,79 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Load the artwork images. When the game is built with 
+ * BORINGSUDOKU_EMBEDDED_ARTWORK, the images are taken from the pre-decoded 
+ * pixels that are compiled into the binary, so no file is read and no PNG 
+ * is decoded. Otherwise (or if the image isn't embedded), the image is 
+ * loaded from the file.
+ *
+ * The embedded pixels are generated by the build step:
+ *
+ *   python tools/embedartwork.py artwork source/embeddedartworkdata.cpp
+ *
+ * The Visual Studio project runs it as a pre-build event, and defines the
+ * flag. Each image's RGBA pixels are stored as an LZ4 block: a sequence of
+ * literal bytes followed by a match that copies the bytes at an offset back
+ * in the output.
+ */
+
+#ifndef __EMBEDDEDARTWORK_H_
+#define __EMBEDDEDARTWORK_H_
+
+#include <string>
+#include <SFML/Graphics.hpp>
+
+///
+/// \brief An embedded image, as generated by tools/embedartwork.py
+///
+struct EmbeddedArtworkImage {
+    const char          *filename;
+    unsigned int         width;
+    unsigned int         height;
+    const unsigned char *data;
+    unsigned int         dataSize;
+};
+
+///
+/// \brief The embedded images, defined in the generated
+///        embeddedartworkdata.cpp
+///
+extern const EmbeddedArtworkImage _embeddedArtwork[];
+
+///
+/// \brief The no of embedded images
+///
+extern const unsigned int _embeddedArtworkCount;
+
+///
+/// \brief Load the artwork image, from the embedded pixels if possible
+///
+/// \param filename The image file name, relative to the game directory
+/// \param image    The image to be loaded
+///
+/// \return true if the image is loaded
+///
+bool EmbeddedArtwork_loadImage(const std::string &filename, sf::Image *image);
+
+#endif // __EMBEDDEDARTWORK_H_
@@ -0,0 +1,153 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Render backend that records the draw commands of a frame, so they can be
+ * drawn later by another thread. The snapshot also keeps the screen regions
+ * that have changed in the frame.
+ */
+
+#ifndef __FRAMESNAPSHOT_H_
+#define __FRAMESNAPSHOT_H_
+
+#include <vector>
+#include "abstractrenderbackend.h"
+
+class FrameSnapshot : public AbstractRenderBackend {
+public:
+    explicit FrameSnapshot();
+
+    //-------------------------------------------------------------------------
+    // Override the AbstractRenderBackend's methods
+    virtual void drawQuads(const sf::Vertex    *vertex, 
+                           unsigned int         vertexCount,
+                           const sf::Texture   *texture,
+                           const sf::Shader    *shader,
+                           const sf::Transform &transform);
+    virtual void updateTexture(sf::Texture     *texture, 
+                               const sf::Uint8 *pixels);
+
+    ///
+    /// \brief Draw the recorded commands into another backend
+    ///
+    /// \param backend The backend that executes the commands
+    ///
+    void draw(AbstractRenderBackend *backend) const;
+
+    ///
+    /// \brief Forget all of the recorded commands and changed regions
+    ///
+    void clear();
+
+    ///
+    /// \brief Add a changed region of the screen
+    ///
+    /// \param rect The changed region
+    ///
+    void addDirtyRect(const sf::IntRect &rect);
+
+    ///
+    /// \brief Mark the whole screen as changed
+    ///
+    void invalidateAll();
+
+    ///
+    /// \brief Add the changed regions of another snapshot, e.g. when that 
+    ///        snapshot is replaced before it's drawn
+    ///
+    /// \param snapshot The other snapshot
+    ///
+    void addDirtyRegion(const FrameSnapshot &snapshot);
+
+    ///
+    /// \brief Check whether the whole screen has changed
+    ///
+    /// \return true if the whole screen has to be redrawn
+    ///
+    bool isAllDirty() const {
+        return _isAllDirty;
+    }
+
+    ///
+    /// \brief Get the changed regions (not including the whole screen flag)
+    ///
+    /// \return The changed regions
+    ///
+    const std::vector<sf::IntRect> &dirtyRects() const {
+        return _dirtyRects;
+    }
+
+private:
+    ///
+    /// \brief A recorded draw command
+    ///
+    struct FrameSnapshotCommand {
+        const sf::Texture *texture;
+        const sf::Shader  *shader;
+        sf::Transform      transform;
+        unsigned int       firstVertex;
+        unsigned int       vertexCount;
+    };
+
+    ///
+    /// \brief A recorded texture update. It's executed before the draw 
+    ///        commands, the pixels are copied since the game loop keeps 
+    ///        changing its own copy.
+    ///
+    struct FrameSnapshotTextureUpdate {
+        sf::Texture  *texture;
+        unsigned int  firstPixel;
+    };
+
+    ///
+    /// \brief The vertex of all of the recorded commands
+    ///
+    std::vector<sf::Vertex> _vertex;
+
+    ///
+    /// \brief The recorded commands, in the drawing order
+    ///
+    std::vector<FrameSnapshotCommand> _commands;
+
+    ///
+    /// \brief The recorded texture updates
+    ///
+    std::vector<FrameSnapshotTextureUpdate> _textureUpdates;
+
+    ///
+    /// \brief The pixels of all of the recorded texture updates
+    ///
+    std::vector<sf::Uint8> _pixels;
+
+    ///
+    /// \brief The changed regions of the screen
+    ///
+    std::vector<sf::IntRect> _dirtyRects;
+
+    ///
+    /// \brief Flag to indicate that the whole screen has changed
+    ///
+    bool _isAllDirty;
+};
+
+#endif // __FRAMESNAPSHOT_H_
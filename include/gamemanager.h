@@ -25,6 +25,24 @@
 #define __GAMEMANAGER_H_
 
 #include "abstractgamestate.h"
+#include "spritebatch.h"
+
+///
+/// \brief The frame pacing policy of the game loop
+///
+enum _framePacing {
+    ///
+    /// \brief Draw a new frame continuously, at the frame rate limit
+    ///
+    FRAMEPACING_CONTINUOUS,
+
+    ///
+    /// \brief Only draw a new frame when there's an input, or when the game 
+    ///        state has a pending update (see AbstractViewer::
+    ///        timeToNextUpdate()). Otherwise the game loop sleeps.
+    ///
+    FRAMEPACING_EVENT_DRIVEN
+};
 
 ///
 /// \brief Init the game manager
@@ -57,9 +75,79 @@ void GameManager_popGameState();
 ///
 void GameManager_stop();
 
+///
+/// \brief Enable / disable the partial redraw mode
+///
+/// In the partial redraw mode, only the screen regions that are reported as 
+/// changed (see dirtyregion.h) are redrawn into a persistent back buffer. 
+/// The mode is enabled by default if the back buffer can be created.
+///
+/// \param enable true to only redraw the changed regions
+///
+void GameManager_setPartialRedraw(bool enable);
+
+///
+/// \brief Set the frame pacing policy of the game loop
+///
+/// The event driven pacing is used by default.
+///
+/// \param pacing The frame pacing policy
+///
+void GameManager_setFramePacing(enum _framePacing pacing);
+
+///
+/// \brief Set the maximum no of frames that's drawn per second
+///
+/// \param frameRate The maximum frame rate, or 0 for no limit
+///
+void GameManager_setFrameRateLimit(unsigned int frameRate);
+
+///
+/// \brief Enable / disable the vertical synchronization
+///
+/// The vertical sync is enabled by default. It's only a request to the 
+/// graphic driver, so the frame rate limit is still applied when it's 
+/// enabled.
+///
+/// \param enable true to sync the frames with the monitor's refresh rate
+///
+void GameManager_setVerticalSync(bool enable);
+
+///
+/// \brief Get the drawing statistic of the last frame
+///
+/// \return The no of draw calls, vertex and texture switches of the last 
+///         frame
+///
+const SpriteBatchStats &GameManager_renderStats();
+
+///
+/// \brief Get the queue latency of the last key
+///
+/// \return The time between polling the last key from the system and 
+///         sending it to the game state. The time the key has waited in 
+///         the system's queue before it's polled isn't included.
+///
+sf::Time GameManager_queueLatency();
+
+///
+/// \brief Get the last frame of the game state that's covered by the 
+///        overlay on top of the stack (see AbstractGameState::isOverlay())
+///
+/// The frame is captured once when the overlay is pushed. Only the overlay 
+/// is drawn after that, the covered game state is neither updated nor drawn.
+///
+/// \return The frozen frame (window sized), or NULL if there's none
+///
+const sf::Texture *GameManager_frozenFrame();
+
 ///
 /// \brief Run the game
 ///
+/// The events and the game states are processed in the calling thread. Each
+/// frame is recorded into a snapshot, and drawn into the window by a 
+/// separate render thread.
+///
 void GameManager_run();
 
 #endif // __GAMEMANAGER_H_
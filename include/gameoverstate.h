@@ -33,6 +33,7 @@
 #include "boardview.h"
 #include "menulayout.h"
 #include "scorelayout.h"
+#include "texturecache.h"
 
 class GameOverState : public AbstractGameState {
 public:
@@ -51,13 +52,13 @@ public:
     //-------------------------------------------------------------------------
     // AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
 
 private:
     ///
     /// \brief The background texture
     ///
-    sf::Texture _backgroundTexture;
+    SharedTexture _backgroundTexture;
 
     //-------------------------------------------------------------------------
     ///
@@ -0,0 +1,120 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Construct a game state speculatively in a worker thread, before it's 
+ * needed. E.g. the play state is built while the player is still choosing 
+ * the difficulty, so selecting it switches to the play state immediately.
+ * The resources that need the game loop's thread are created when the game
+ * state is pushed (see AbstractGameState::loadGraphics()).
+ */
+
+#ifndef __GAMESTATEBUILDER_H_
+#define __GAMESTATEBUILDER_H_
+
+#include <string>
+#include <vector>
+#include "abstractgamestate.h"
+#include "jobsystem.h"
+#include "texturecache.h"
+
+///
+/// \brief Create a new game state. Called in a worker thread, or in the game
+///        loop's thread if the game state is needed before it's built.
+///
+typedef AbstractGameState *(*GameStateFactory)();
+
+class GameStateBuilder {
+public:
+    explicit GameStateBuilder();
+
+    ///
+    /// \brief Cancel the building, and release the game state to its pool 
+    ///        if it hasn't been taken
+    ///
+    ~GameStateBuilder();
+
+    ///
+    /// \brief Start building the game state in the background
+    ///
+    /// \param factory  The function that creates the game state
+    /// \param textures The textures used by the game state. They're loaded 
+    ///                 here, so the worker only shares them.
+    ///
+    void start(GameStateFactory                factory, 
+               const std::vector<std::string> &textures);
+
+    ///
+    /// \brief Get the game state. If it's not built yet, the building is 
+    ///        cancelled, and the game state is created immediately instead.
+    ///
+    /// \return The game state, owned by the caller from now on. NULL if 
+    ///         start() hasn't been called.
+    ///
+    AbstractGameState *take();
+
+    ///
+    /// \brief Receive the game state from the worker. Called in the game 
+    ///        loop's thread.
+    ///
+    /// \param state The built game state
+    ///
+    void setGameState(AbstractGameState *state);
+
+private:
+    // The job refers to the builder, so it can't be copied
+    GameStateBuilder(const GameStateBuilder &other);
+    GameStateBuilder &operator=(const GameStateBuilder &other);
+
+    ///
+    /// \brief Stop building, and release the textures
+    ///
+    void reset();
+
+    ///
+    /// \brief The function that creates the game state
+    ///
+    GameStateFactory _factory;
+
+    ///
+    /// \brief The textures that are kept loaded while building
+    ///
+    std::vector<SharedTexture> _textures;
+
+    ///
+    /// \brief The job that builds the game state
+    ///
+    JobId _jobId;
+
+    ///
+    /// \brief Flag to indicate that the job hasn't completed yet
+    ///
+    bool _isBuilding;
+
+    ///
+    /// \brief The built game state, or NULL
+    ///
+    AbstractGameState *_gameState;
+};
+
+#endif // __GAMESTATEBUILDER_H_
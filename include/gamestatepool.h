@@ -0,0 +1,62 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Keep the game states that are removed from the stack, so they can be 
+ * reused instead of constructing new ones. A recycled game state keeps its
+ * views, textures and graphic resources, and is only reset to its initial 
+ * content. The game states opt in by returning a pool name from 
+ * AbstractGameState::poolName().
+ */
+
+#ifndef __GAMESTATEPOOL_H_
+#define __GAMESTATEPOOL_H_
+
+#include <string>
+#include "abstractgamestate.h"
+
+///
+/// \brief Keep the game state to be reused, or delete it if it can't be 
+///        reused or its pool is full
+///
+/// \param state The game state that's no longer used, can be NULL
+///
+void GameStatePool_release(AbstractGameState *state);
+
+///
+/// \brief Take a game state from the pool. It can be called from any 
+///        thread.
+///
+/// \param poolName The game state's pool name
+///
+/// \return The game state, or NULL if the pool is empty. The caller has to 
+///         reset it before it's used.
+///
+AbstractGameState *GameStatePool_acquire(const std::string &poolName);
+
+///
+/// \brief Delete all of the game states in the pools
+///
+void GameStatePool_clear();
+
+#endif // __GAMESTATEPOOL_H_
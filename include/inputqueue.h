@@ -0,0 +1,111 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Queue the user's input with the time it was received. The events are 
+ * mapped to the game keys when they're captured, stored in a fixed-size 
+ * lock-free single-producer / single-consumer ring, and drained by the game
+ * loop in between its update steps. The counters of the ring are atomics 
+ * with release / acquire ordering, so the producer and the consumer can run 
+ * in different threads, as long as there's only one of each. SFML only 
+ * delivers the events in the window's thread, so both ends of the ring 
+ * currently run in the game thread.
+ *
+ * SFML's events don't carry the time the system received them, so the 
+ * timestamp is the time the game loop has polled the event. The time the 
+ * event has waited in the system's queue (e.g. during a long frame) isn't 
+ * included, only the time from polling the event until it's processed.
+ */
+
+#ifndef __INPUTQUEUE_H_
+#define __INPUTQUEUE_H_
+
+#include <SFML/Window.hpp>
+#include "abstractcontroller.h"
+
+///
+/// \brief A game key, with the time it was received
+///
+struct InputEvent {
+    ///
+    /// \brief The game key
+    ///
+    enum AbstractController::_keys key;
+
+    ///
+    /// \brief The time the key was polled from the system (see 
+    ///        InputQueue_now()), which can be later than the key press
+    ///
+    sf::Time timestamp;
+};
+
+///
+/// \brief Get the current time of the input clock
+///
+/// \return The time since the input queue has started
+///
+sf::Time InputQueue_now();
+
+///
+/// \brief Map the system's key event to the game key
+///
+/// \param keyEvent The key event from the system
+/// \param key      The game key to be filled
+///
+/// \return true if the key is used by the game
+///
+bool InputQueue_mapKey(const sf::Event::KeyEvent      &keyEvent, 
+                       enum AbstractController::_keys *key);
+
+///
+/// \brief Add the game key to the end of the queue. Only called by the 
+///        producer (the thread that polls the window's events).
+///
+/// \param key       The game key
+/// \param timestamp The time the key was received
+///
+/// \return false if the queue is full, and the key is dropped
+///
+bool InputQueue_push(enum AbstractController::_keys key, sf::Time timestamp);
+
+///
+/// \brief Take the oldest game key from the queue. Only called by the 
+///        consumer (the game loop).
+///
+/// \param inputEvent The input event to be filled
+///
+/// \return false if the queue is empty
+///
+bool InputQueue_pop(InputEvent *inputEvent);
+
+///
+/// \brief Read the oldest game key without taking it from the queue. Only 
+///        called by the consumer (the game loop).
+///
+/// \param inputEvent The input event to be filled
+///
+/// \return false if the queue is empty
+///
+bool InputQueue_peek(InputEvent *inputEvent);
+
+#endif // __INPUTQUEUE_H_
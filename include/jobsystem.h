@@ -0,0 +1,135 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Run the long jobs (e.g. puzzle generation, solving, asset decoding) in a 
+ * pool of worker threads. The jobs' completion is reported back in the game 
+ * loop's thread, so the game states never have to deal with the threads.
+ */
+
+#ifndef __JOBSYSTEM_H_
+#define __JOBSYSTEM_H_
+
+#include <SFML/System.hpp>
+
+///
+/// \brief The id of a submitted job, used to cancel it
+///
+typedef unsigned int JobId;
+
+///
+/// \brief The priority of a job. The queued jobs with higher priority are 
+///        started first.
+///
+enum _jobPriority {
+    JOB_PRIORITY_HIGH,
+    JOB_PRIORITY_NORMAL,
+    JOB_PRIORITY_LOW,
+    JOB_PRIORITY_COUNT
+};
+
+class AbstractJob {
+public:
+    ///
+    /// \brief Do the job. Called in a worker thread, so it must not touch 
+    ///        the game states or the views.
+    ///
+    /// Long jobs should check isCancelled() regularly, and return early when
+    /// it's set.
+    ///
+    virtual void run() = 0;
+
+    ///
+    /// \brief Use the job's result. Called in the game loop's thread after 
+    ///        run() has finished, unless the job has been cancelled.
+    ///
+    virtual void complete() { }
+
+    ///
+    /// \brief Check whether the job has been cancelled
+    ///
+    /// \return true if the job has been cancelled
+    ///
+    bool isCancelled();
+
+    ///
+    /// \brief The job's destructor. Called in the game loop's thread.
+    ///
+    virtual ~AbstractJob() { }
+};
+
+///
+/// \brief Start the worker threads
+///
+/// \param workerCount The no of worker threads, or 0 to use one less than 
+///                    the no of processors
+///
+void JobSystem_init(unsigned int workerCount = 0);
+
+///
+/// \brief Queue a job to be run by the workers
+///
+/// The job system owns the job, and deletes it when it's completed or 
+/// cancelled. The game state that submits a job must cancel it before the 
+/// game state is deleted.
+///
+/// \param job      The job to be run
+/// \param priority The job's priority
+///
+/// \return The job's id
+///
+JobId JobSystem_submit(AbstractJob       *job, 
+                       enum _jobPriority  priority = JOB_PRIORITY_NORMAL);
+
+///
+/// \brief Cancel a job. A queued job is never run, a running job is asked to
+///        stop (see AbstractJob::isCancelled()), and the job's complete() is
+///        never called.
+///
+/// \param id The job's id. Ignored if the job is already completed.
+///
+void JobSystem_cancel(JobId id);
+
+///
+/// \brief Call complete() for the finished jobs. Called by the game loop on
+///        every frame.
+///
+/// \param timeBudget The maximum time to spend. At least one job is always
+///                   completed, if there's any.
+///
+void JobSystem_processCompleted(sf::Time timeBudget);
+
+///
+/// \brief Check whether there are jobs that haven't been completed yet
+///
+/// \return true if there are queued, running, or finished jobs
+///
+bool JobSystem_hasPendingJobs();
+
+///
+/// \brief Stop the worker threads, and delete the jobs that are left 
+///        without completing them
+///
+void JobSystem_shutdown();
+
+#endif // __JOBSYSTEM_H_
@@ -33,6 +33,7 @@
 #include "boardmodeladapter.h"
 #include "boardview.h"
 #include "menulayout.h"
+#include "texturecache.h"
 
 class MenuState : public AbstractGameState {
 public:
@@ -46,13 +47,13 @@ public:
     //-------------------------------------------------------------------------
     // AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
 
 private:
     ///
     /// \brief The background texture
     ///
-    sf::Texture _backgroundTexture;
+    SharedTexture _backgroundTexture;
 
     //-------------------------------------------------------------------------
     ///
@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Render backend that doesn't draw anything, it only counts the commands. 
+ * Used to measure the views without a display.
+ */
+
+#ifndef __NULLRENDERBACKEND_H_
+#define __NULLRENDERBACKEND_H_
+
+#include "abstractrenderbackend.h"
+
+class NullRenderBackend : public AbstractRenderBackend {
+public:
+    explicit NullRenderBackend();
+
+    //-------------------------------------------------------------------------
+    // Override the AbstractRenderBackend's methods
+    virtual void drawQuads(const sf::Vertex    *vertex, 
+                           unsigned int         vertexCount,
+                           const sf::Texture   *texture,
+                           const sf::Shader    *shader,
+                           const sf::Transform &transform);
+
+    ///
+    /// \brief Reset all of the counters to 0
+    ///
+    void reset();
+
+    ///
+    /// \brief Get the no of draw commands
+    ///
+    /// \return The no of draw commands since the last reset()
+    ///
+    unsigned int drawCalls() const {
+        return _drawCalls;
+    }
+
+    ///
+    /// \brief Get the no of vertex
+    ///
+    /// \return The no of vertex since the last reset()
+    ///
+    unsigned int vertices() const {
+        return _vertices;
+    }
+
+    ///
+    /// \brief Get the no of texture changes between the draw commands
+    ///
+    /// \return The no of texture changes since the last reset()
+    ///
+    unsigned int textureSwitches() const {
+        return _textureSwitches;
+    }
+
+    ///
+    /// \brief Get the no of shader changes between the draw commands
+    ///
+    /// \return The no of shader changes since the last reset()
+    ///
+    unsigned int shaderSwitches() const {
+        return _shaderSwitches;
+    }
+
+private:
+    ///
+    /// \brief The no of draw commands
+    ///
+    unsigned int _drawCalls;
+
+    ///
+    /// \brief The no of vertex
+    ///
+    unsigned int _vertices;
+
+    ///
+    /// \brief The no of texture changes
+    ///
+    unsigned int _textureSwitches;
+
+    ///
+    /// \brief The no of shader changes
+    ///
+    unsigned int _shaderSwitches;
+
+    ///
+    /// \brief The texture of the last draw command
+    ///
+    const sf::Texture *_lastTexture;
+
+    ///
+    /// \brief The shader of the last draw command
+    ///
+    const sf::Shader *_lastShader;
+};
+
+#endif // __NULLRENDERBACKEND_H_
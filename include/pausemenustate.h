@@ -33,12 +33,17 @@
 #include "boardmodeladapter.h"
 #include "boardview.h"
 #include "menulayout.h"
+#include "texturecache.h"
 
 class PauseMenuState : public AbstractGameState {
 public:
     explicit PauseMenuState();
     virtual ~PauseMenuState();
 
+    //-------------------------------------------------------------------------
+    // AbstractGameState methods
+    virtual bool isOverlay() const;
+
     //-------------------------------------------------------------------------
     // Abstractcontroller methods
     virtual void processKeypressEvent(enum _keys key);
@@ -46,13 +51,13 @@ public:
     //-------------------------------------------------------------------------
     // AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
 
 private:
     ///
     /// \brief The background texture
     ///
-    sf::Texture _backgroundTexture;
+    SharedTexture _backgroundTexture;
 
     //-------------------------------------------------------------------------
     ///
@@ -0,0 +1,99 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * The pencil mark layout places the candidate marks inside the Sudoku board
+ * tiles. Each tile is split into small grid (3x3 for 9x9 board), and digit n
+ * is placed in the n-th cell of that grid. The marks are scaled down when 
+ * the grid's cells are smaller than the marks (16x16 and 25x25 boards), so
+ * they never spill into the neighbouring tiles.
+ */
+
+#ifndef __PENCILMARKLAYOUT_H_
+#define __PENCILMARKLAYOUT_H_
+
+#include "sudokuboardlayout.h"
+
+class PencilMarkLayout : public SudokuBoardLayout {
+public:
+    ///
+    /// \brief Init the pencil mark layout
+    ///
+    /// \param board        The board model
+    /// \param tileSize     The board's tile size
+    /// \param markSize     The pencil mark size
+    /// \param screenSize   The drawable screen size
+    /// \param screenOffset The offset of the drawable screen from the real
+    ///                     screen
+    ///
+    PencilMarkLayout(BoardModelAdapter *board        = NULL, 
+                     sf::Vector2u       tileSize     = sf::Vector2u(0, 0),
+                     sf::Vector2u       markSize     = sf::Vector2u(0, 0),
+                     sf::Vector2f       screenSize   = sf::Vector2f(0, 0), 
+                     sf::Vector2f       screenOffset = sf::Vector2f(0, 0)
+    );
+    
+    virtual ~PencilMarkLayout();
+
+    ///
+    /// \brief Get the pencil mark's screen coordinate
+    ///
+    /// \param row    The row where the tile's reside
+    /// \param column The column where the tile's reside
+    /// \param digit  The digit of the pencil mark (starting from 1)
+    ///
+    /// \return The pencil mark's center position in screen
+    ///
+    sf::Vector2f markPositionInScreen(int row, int column, unsigned int digit);
+
+    ///
+    /// \brief Read the pencil mark size 
+    ///
+    sf::Vector2u markSize() const;
+
+    ///
+    /// \brief Get the size of the pencil mark on the screen: the mark size, 
+    ///        scaled down to fit in the cell of the tile's mark grid
+    ///
+    /// \return The drawn pencil mark size (in pixel)
+    ///
+    sf::Vector2f markSizeInScreen() const;
+
+private:
+    ///
+    /// \brief Get the no of pencil marks in each row of the tile's mark grid
+    ///
+    unsigned int marksPerRow() const;
+
+    ///
+    /// \brief Get the size of a cell in the tile's mark grid
+    ///
+    sf::Vector2f markCellSize() const;
+
+    ///
+    /// \brief The pencil mark size (in pixel)
+    ///
+    sf::Vector2u _markSize;
+};
+
+#endif // __PENCILMARKLAYOUT_H_
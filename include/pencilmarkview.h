@@ -0,0 +1,127 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Display the candidates of every empty tile as small pencil marks. All of 
+ * the marks are stored in a single vertex array, so the whole notes can be 
+ * drawn with one draw call. Only the tiles whose candidates have changed are
+ * regenerated.
+ */
+
+#ifndef __PENCILMARKVIEW_H_
+#define __PENCILMARKVIEW_H_
+
+#include <vector>
+#include "abstractviewer.h"
+#include "pencilmarklayout.h"
+#include "sudokucandidategrid.h"
+#include "tilefacetable.h"
+#include "texturecache.h"
+
+class PencilMarkView : public AbstractViewer {
+public:
+    ///
+    /// \brief The pencil mark's view constructor
+    ///
+    /// \param grid            The candidate grid
+    /// \param layout          The pencil mark layout
+    /// \param tilemapFilename The pencil mark tilemap texture. Tile #n in 
+    ///                        the tilemap is the mark for digit n
+    ///
+    explicit PencilMarkView(const SudokuCandidateGrid *grid            = NULL,
+                            PencilMarkLayout          *layout          = NULL,
+                            const std::string         &tilemapFilename = ""
+    );
+
+    //-------------------------------------------------------------------------
+    // Override the AbstractViewer's methods
+    virtual void update(sf::Time elapsedTime);
+    virtual void draw(SpriteBatch *batch);
+
+    ///
+    /// \brief Virtual destructor so this class can be overridden
+    ///
+    virtual ~PencilMarkView() { }
+
+private:
+    ///
+    /// \brief Regenerate the marks' vertex of a single tile
+    ///
+    /// \param tile The tile index (row * boardSize + column)
+    ///
+    void updateTileMarks(unsigned int tile);
+
+    ///
+    /// \brief The candidate grid
+    ///
+    const SudokuCandidateGrid *_grid;
+
+    ///
+    /// \brief The pencil mark tilemap texture
+    ///
+    SharedTexture _markTexture;
+
+    ///
+    /// \brief The pencil mark size in the tilemap (in pixel)
+    ///
+    sf::Vector2u _markSize;
+
+    ///
+    /// \brief The pencil mark size on the screen, scaled down to fit in the 
+    ///        tile (in pixel)
+    ///
+    sf::Vector2f _markSizeInScreen;
+
+    ///
+    /// \brief The texture coordinates of each mark in the tilemap
+    ///
+    const TileFaceTable *_faceTable;
+
+    ///
+    /// \brief The number of marks (digits) in each tile
+    ///
+    unsigned int _marksPerTile;
+
+    ///
+    /// \brief The center position of each mark in the screen. Mark for digit
+    ///        n in tile t is stored at (t * _marksPerTile) + (n - 1)
+    ///
+    std::vector<sf::Vector2f> _markPosition;
+
+    ///
+    /// \brief The candidate mask that's currently displayed for each tile
+    ///
+    std::vector<unsigned int> _tileMask;
+
+    ///
+    /// \brief The candidate grid version that's currently displayed
+    ///
+    unsigned int _gridVersion;
+
+    ///
+    /// \brief The marks' vertex to draw (4 vertex for each mark)
+    ///
+    std::vector<sf::Vertex> _vertex;
+};
+
+#endif // __PENCILMARKVIEW_H_
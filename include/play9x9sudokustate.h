@@ -24,25 +24,66 @@
 #ifndef __PLAY9X9SUDOKUSTATE_H_
 #define __PLAY9X9SUDOKUSTATE_H_
 
+#include <string>
+#include <vector>
 #include <SFML/Graphics.hpp>
 #include "abstractgamestate.h"
+#include "bitboard.h"
 #include "boardmodeladapter.h"
 #include "boardlayout.h"
 #include "boardview.h"
+#include "conflictview.h"
 #include "cursorcontroller.h"
 #include "cursoreventobserver.h"
 #include "cursorview.h"
+#include "pencilmarklayout.h"
+#include "pencilmarkview.h"
 #include "scorelayout.h"
+#include "shaderboardview.h"
 #include "sudokuboardlayout.h"
 #include "sudokugame.h"
 #include "sudokuscore.h"
+#include "texturecache.h"
 
 class Play9x9SudokuState : public AbstractGameState, public CursorEventObserver
 {
 public:
+    ///
+    /// \brief Create the game, without the shader board and the static 
+    ///        layer (see loadGraphics()). It can be run in a worker thread, 
+    ///        once the textures in textureFilenames() have been loaded.
+    ///
     explicit Play9x9SudokuState();
     virtual ~Play9x9SudokuState();
 
+    ///
+    /// \brief Get the textures that are used by the game state
+    ///
+    /// \param names The textures' file names are appended here
+    ///
+    static void textureFilenames(std::vector<std::string> *names);
+
+    ///
+    /// \brief Reuse a play state from the pool, reset to a new game, or 
+    ///        construct a new one. It can be called in a worker thread.
+    ///
+    /// \return The play state
+    ///
+    static Play9x9SudokuState *create();
+
+    ///
+    /// \brief Start a new game in place, keeping the views and the graphic
+    ///        resources
+    ///
+    /// \param puzzle The puzzle's 81 tiles, row by row (0 for empty tiles)
+    ///
+    void reset(const unsigned int *puzzle);
+
+    //-------------------------------------------------------------------------
+    // AbstractGameState methods
+    virtual void loadGraphics();
+    virtual const char *poolName() const;
+
     //-------------------------------------------------------------------------
     // Abstractcontroller methods
     virtual void processKeypressEvent(enum _keys key);
@@ -50,7 +91,8 @@ public:
     //-------------------------------------------------------------------------
     // AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
+    virtual sf::Time timeToNextUpdate();
 
     //-------------------------------------------------------------------------
     // CursorEventObserver's methods
@@ -58,16 +100,52 @@ public:
                               sf::Vector2i              tilePos,
                               AbstractController::_keys key);
 private:
+    ///
+    /// \brief Jump the sudoku board's cursor to the tile that's requested by
+    ///        the navigation key
+    ///
+    /// \param key The navigation key (KEY_NEXT_EMPTY, KEY_NEXT_FEWEST or
+    ///            KEY_SEEK_1 .. KEY_SEEK_9)
+    ///
+    /// \return true if the key is a navigation key
+    ///
+    bool navigateCursor(enum _keys key);
+
     ///
     /// \brief Create the keypad
     ///
     void createKeypad();
 
+    ///
+    /// \brief Score the tiles that were placed in conflict, once their 
+    ///        conflict has been cleared
+    ///
+    void scoreResolvedConflicts();
+
+    ///
+    /// \brief Show the conflict view in highlight conflicts mode, or while 
+    ///        there are conflicts on the board
+    ///
+    void updateConflictView();
+
     ///
     /// \brief Create the Sudoku board
     ///
     void createSudokuBoard();
 
+    ///
+    /// \brief Load the puzzle into the sudoku model
+    ///
+    /// \param puzzle The puzzle's tiles, row by row (0 for empty tiles)
+    ///
+    void loadPuzzle(const unsigned int *puzzle);
+
+    ///
+    /// \brief Render the parts that don't change during the game (the 
+    ///        background and the puzzle) into the static layer
+    ///
+    void renderStaticLayer();
+
     //-------------------------------------------------------------------------
     ///
     /// \brief The sudoku game
@@ -83,7 +161,16 @@ private:
     ///
     /// \brief The background texture
     ///
-    sf::Texture _backgroundTexture;
+    SharedTexture _backgroundTexture;
+
+    ///
+    /// \brief The background and the puzzle, rendered once when the puzzle 
+    ///        is loaded. It's created in loadGraphics(), since the game 
+    ///        state can be constructed in a worker thread. NULL if it can't 
+    ///        be created, then the background and the puzzle are drawn 
+    ///        every frame.
+    ///
+    sf::RenderTexture *_staticLayer;
 
     //-------------------------------------------------------------------------
     ///
@@ -116,6 +203,54 @@ private:
     ///
     BoardView _sudokuUserView;
 
+    ///
+    /// \brief The whole sudoku board in a single quad, drawn by a shader. 
+    ///        NULL if shaders are not supported, then _sudokuView and 
+    ///        _sudokuUserView are used.
+    ///
+    ShaderBoardView *_shaderBoardView;
+
+    ///
+    /// \brief Flag to indicate that the shader board and the static layer 
+    ///        have been created
+    ///
+    bool _isGraphicsLoaded;
+
+    ///
+    /// \brief Flag to indicate that the static layer has to be redrawn, 
+    ///        since the puzzle has changed
+    ///
+    bool _isStaticLayerStale;
+
+    //-------------------------------------------------------------------------
+    ///
+    /// \brief The pencil mark layout (candidates inside the sudoku tiles)
+    ///
+    PencilMarkLayout _pencilMarkLayout;
+
+    ///
+    /// \brief The pencil mark view (candidates of the empty tiles)
+    ///
+    PencilMarkView _pencilMarkView;
+
+    //-------------------------------------------------------------------------
+    ///
+    /// \brief Flag to indicate that conflicting digits are accepted and 
+    ///        highlighted, instead of being rejected
+    ///
+    bool _highlightConflicts;
+
+    ///
+    /// \brief The conflict view (highlight of the conflicting tiles)
+    ///
+    ConflictView _conflictView;
+
+    ///
+    /// \brief The tiles that were placed in conflict, and haven't been 
+    ///        scored yet
+    ///
+    Bitboard _pendingScoreTiles;
+
     //-------------------------------------------------------------------------
     ///
     /// \brief The sudoku's board cursor model
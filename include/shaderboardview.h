@@ -0,0 +1,145 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Draw the whole board with a single quad. The tile values are uploaded as a
+ * tiny data texture (one pixel per tile), and a fragment shader picks the 
+ * tile face from the tilemaps. The CPU cost doesn't depend on the board size.
+ *
+ * The shader only uses GLSL 1.10, so it also runs on the Mesa software 
+ * rasteriser. If shaders are not available, use BoardView instead.
+ */
+
+#ifndef __SHADERBOARDVIEW_H_
+#define __SHADERBOARDVIEW_H_
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "abstractviewer.h"
+#include "boardlayout.h"
+#include "boardmodeladapter.h"
+#include "texturecache.h"
+
+class ShaderBoardView : public AbstractViewer, private sf::NonCopyable {
+public:
+    ///
+    /// \brief Create the board view
+    ///
+    /// The masked tiles are drawn with the given tilemap, the others with the
+    /// user tilemap. Both tilemaps must have the same tile size as the 
+    /// layout.
+    ///
+    /// \param board               The board's model
+    /// \param layout              The board's layout
+    /// \param givenTilemapFilename The tilemap for the masked tiles
+    /// \param userTilemapFilename  The tilemap for the other tiles
+    ///
+    explicit ShaderBoardView(BoardModelAdapter *board,
+                             BoardLayout       *layout,
+                             const std::string &givenTilemapFilename,
+                             const std::string &userTilemapFilename);
+
+    ///
+    /// \brief Check whether the view can be used (the shader is loaded)
+    ///
+    /// \return true if the view can be drawn
+    ///
+    bool isLoaded() const {
+        return _isLoaded;
+    }
+
+    //-------------------------------------------------------------------------
+    // Override the AbstractViewer's methods
+    virtual void update(sf::Time elapsedTime);
+    virtual void draw(SpriteBatch *batch);
+
+    ///
+    /// \brief Virtual destructor so this class can be overridden
+    ///
+    virtual ~ShaderBoardView() { }
+
+private:
+    ///
+    /// \brief The board model
+    ///
+    BoardModelAdapter *_board;
+
+    ///
+    /// \brief The tilemap for the masked (given) tiles
+    ///
+    SharedTexture _givenTilemap;
+
+    ///
+    /// \brief The tilemap for the user's tiles
+    ///
+    SharedTexture _userTilemap;
+
+    ///
+    /// \brief The tile size in pixel
+    ///
+    sf::Vector2u _tileSize;
+
+    ///
+    /// \brief The tile's top-left corner in the screen, for each column (x) 
+    ///        and row (y)
+    ///
+    std::vector<sf::Vector2f> _tileCorner;
+
+    ///
+    /// \brief The tile data (one RGBA pixel per tile: face, given flag)
+    ///
+    std::vector<sf::Uint8> _tileData;
+
+    ///
+    /// \brief The tile data texture
+    ///
+    sf::Texture _tileTexture;
+
+    ///
+    /// \brief The tile position texture (one RGBA pixel per column / row: 
+    ///        16 bit x, 16 bit y of the tile's top-left corner)
+    ///
+    sf::Texture _layoutTexture;
+
+    ///
+    /// \brief The board's fragment shader
+    ///
+    sf::Shader _shader;
+
+    ///
+    /// \brief The quad that covers the whole board
+    ///
+    sf::Vertex _vertex[4];
+
+    ///
+    /// \brief The board model version that's currently uploaded
+    ///
+    unsigned int _boardVersion;
+
+    ///
+    /// \brief Flag to indicate that the shader and its textures are ready
+    ///
+    bool _isLoaded;
+};
+
+#endif // __SHADERBOARDVIEW_H_
@@ -29,6 +29,7 @@
 #define __SPLASHSCREENSTATE_H_
 
 #include "abstractgamestate.h"
+#include "texturecache.h"
 
 class SplashScreenState : public AbstractGameState {
 public:
@@ -42,13 +43,14 @@ public:
     //-------------------------------------------------------------------------
     // AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
+    virtual sf::Time timeToNextUpdate();
 
 private:
     ///
     /// \brief The Splashscreen texture
     ///
-    sf::Texture _texture;
+    SharedTexture _texture;
 
     ///
     /// \brief Track the running time of this state
@@ -0,0 +1,235 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Collect the quads drawn by the views during a frame, and draw them with as
+ * few draw calls as possible. The quads are sorted by layer. Quads in the 
+ * same layer keep the order they were submitted in, so they can overlap, 
+ * and the consecutive quads with the same texture are drawn together.
+ *
+ * The batch only records the draw commands, they are executed by the render
+ * backend on flush().
+ */
+
+#ifndef __SPRITEBATCH_H_
+#define __SPRITEBATCH_H_
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+#include "abstractrenderbackend.h"
+
+///
+/// \brief The drawing layers, from the bottom-most to the top-most
+///
+enum _spriteLayers {
+    SPRITE_LAYER_BACKGROUND,
+    SPRITE_LAYER_CURSOR,
+    SPRITE_LAYER_GIVEN,
+    SPRITE_LAYER_TILE,
+    SPRITE_LAYER_OVERLAY,
+    SPRITE_LAYER_MARK
+};
+
+///
+/// \brief The drawing statistic of a frame
+///
+struct SpriteBatchStats {
+    ///
+    /// \brief The no of draw() submitted to the batch
+    ///
+    unsigned int submissions;
+
+    ///
+    /// \brief The no of draw calls sent to the render target
+    ///
+    unsigned int drawCalls;
+
+    ///
+    /// \brief The no of vertex sent to the render target
+    ///
+    unsigned int vertices;
+
+    ///
+    /// \brief The no of times the texture is changed between draw calls
+    ///
+    unsigned int textureSwitches;
+};
+
+class SpriteBatch {
+public:
+    explicit SpriteBatch();
+
+    ///
+    /// \brief Add quads to be drawn
+    ///
+    /// \param vertex      The quads' vertex (4 vertex for each quad)
+    /// \param vertexCount The no of vertex
+    /// \param texture     The quads' texture, or NULL for untextured quads
+    /// \param layer       The drawing layer
+    /// \param transform   The transform applied to the vertex
+    ///
+    void draw(const sf::Vertex    *vertex, 
+              unsigned int         vertexCount,
+              const sf::Texture   *texture,
+              int                  layer     = SPRITE_LAYER_TILE,
+              const sf::Transform &transform = sf::Transform::Identity);
+
+    ///
+    /// \brief Add quads to be drawn with a shader
+    ///
+    /// \param vertex      The quads' vertex (4 vertex for each quad)
+    /// \param vertexCount The no of vertex
+    /// \param texture     The quads' texture, or NULL for untextured quads
+    /// \param shader      The quads' shader
+    /// \param layer       The drawing layer
+    /// \param transform   The transform applied to the vertex
+    ///
+    void drawWithShader(
+        const sf::Vertex    *vertex, 
+        unsigned int         vertexCount,
+        const sf::Texture   *texture,
+        const sf::Shader    *shader,
+        int                  layer     = SPRITE_LAYER_TILE,
+        const sf::Transform &transform = sf::Transform::Identity
+    );
+
+    ///
+    /// \brief Add a sprite to be drawn
+    ///
+    /// \param sprite The sprite
+    /// \param layer  The drawing layer
+    ///
+    void draw(const sf::Sprite &sprite, int layer = SPRITE_LAYER_TILE);
+
+    ///
+    /// \brief Replace the pixels of a texture before the quads are drawn. 
+    ///        The backend executes it, so the texture isn't changed while 
+    ///        another thread may be drawing with it.
+    ///
+    /// \param texture The texture
+    /// \param pixels  The new pixels (RGBA) for the texture's whole size. 
+    ///                They're copied.
+    ///
+    void updateTexture(sf::Texture *texture, const sf::Uint8 *pixels);
+
+    ///
+    /// \brief Send all of the collected quads to the backend, and empty the 
+    ///        batch
+    ///
+    /// \param backend The render backend
+    ///
+    void flush(AbstractRenderBackend *backend);
+
+    ///
+    /// \brief Draw all of the collected quads to the target, and empty the 
+    ///        batch
+    ///
+    /// \param target The render target
+    ///
+    void flush(sf::RenderTarget *target);
+
+    ///
+    /// \brief Discard all of the collected quads
+    ///
+    void clear();
+
+    ///
+    /// \brief Get the drawing statistic of the last flush()
+    ///
+    /// \return The drawing statistic
+    ///
+    const SpriteBatchStats &stats() const {
+        return _stats;
+    }
+
+private:
+    ///
+    /// \brief The quads submitted by a single draw()
+    ///
+    struct SpriteBatchItem {
+        int                layer;
+        const sf::Texture *texture;
+        const sf::Shader  *shader;
+        sf::Transform      transform;
+        unsigned int       firstVertex;
+        unsigned int       vertexCount;
+    };
+
+    ///
+    /// \brief A texture update, executed before the quads are drawn
+    ///
+    struct SpriteBatchTextureUpdate {
+        sf::Texture  *texture;
+        unsigned int  firstPixel;
+    };
+
+    ///
+    /// \brief Sort the items by layer. It's used with a stable sort, so the 
+    ///        items in the same layer keep their submission order.
+    ///
+    static bool isDrawnBefore(const SpriteBatchItem &a, 
+                              const SpriteBatchItem &b);
+
+    ///
+    /// \brief Check whether both transforms are the same
+    ///
+    static bool isSameTransform(const sf::Transform &a, 
+                                const sf::Transform &b);
+
+    ///
+    /// \brief The submitted vertex, in the submission order
+    ///
+    std::vector<sf::Vertex> _vertex;
+
+    ///
+    /// \brief The submitted items
+    ///
+    std::vector<SpriteBatchItem> _items;
+
+    ///
+    /// \brief The texture updates, in the submission order
+    ///
+    std::vector<SpriteBatchTextureUpdate> _textureUpdates;
+
+    ///
+    /// \brief The pixels of the texture updates
+    ///
+    std::vector<sf::Uint8> _pixels;
+
+    ///
+    /// \brief The vertex, sorted into drawing order
+    ///
+    std::vector<sf::Vertex> _sortedVertex;
+
+    ///
+    /// \brief The no of draw() since the last flush()
+    ///
+    unsigned int _submissions;
+
+    ///
+    /// \brief The drawing statistic of the last flush()
+    ///
+    SpriteBatchStats _stats;
+};
+
+#endif // __SPRITEBATCH_H_
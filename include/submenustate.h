@@ -32,13 +32,32 @@
 #include "abstractgamestate.h"
 #include "boardmodeladapter.h"
 #include "boardview.h"
+#include "gamestatebuilder.h"
 #include "menulayout.h"
+#include "texturecache.h"
 
 class SubMenuState : public AbstractGameState {
 public:
     explicit SubMenuState();
     virtual ~SubMenuState();
 
+    ///
+    /// \brief Reuse a submenu from the pool, or construct a new one
+    ///
+    /// \return The submenu
+    ///
+    static SubMenuState *create();
+
+    ///
+    /// \brief Go back to the first menu item, and start building the play 
+    ///        state again
+    ///
+    void reset();
+
+    //-------------------------------------------------------------------------
+    // AbstractGameState methods
+    virtual const char *poolName() const;
+
     //-------------------------------------------------------------------------
     // Abstractcontroller methods
     virtual void processKeypressEvent(enum _keys key);
@@ -46,13 +65,13 @@ public:
     //-------------------------------------------------------------------------
     // AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
 
 private:
     ///
     /// \brief The background texture
     ///
-    sf::Texture _backgroundTexture;
+    SharedTexture _backgroundTexture;
 
     //-------------------------------------------------------------------------
     ///
@@ -75,6 +94,11 @@ private:
     ///
     BoardView _submenuView;
 
+    ///
+    /// \brief Build the play state in the background
+    ///
+    GameStateBuilder _playStateBuilder;
+
     //-------------------------------------------------------------------------
     ///
     /// \brief The submenu options
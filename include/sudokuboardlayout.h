@@ -41,6 +41,29 @@ public:
     virtual SudokuBoardLayout::~SudokuBoardLayout();
 
     virtual sf::Vector2f tilePositionInScreen(int row, int column);
+
+    ///
+    /// \brief Scale the board down (around the drawable screen's center) if 
+    ///        it doesn't fit into the drawable screen
+    ///
+    virtual sf::Transform screenTransform();
+
+private:
+    ///
+    /// \brief Get the sub-board size (in tiles) of the board
+    ///
+    /// \return The sub-board size, or the board size if the board is not a 
+    ///         square of sub-boards
+    ///
+    int subboardSize();
+
+    ///
+    /// \brief Get the distance (in tile size) from the board's edge to its 
+    ///        center
+    ///
+    /// \return The distance from the board's edge to its center
+    ///
+    float boardCenter();
 };
 
 #endif // __SUDOKUBOARDLAYOUT_H_
@@ -0,0 +1,349 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * The candidate grid keeps the candidates (pencil marks) of every tile in the
+ * Sudoku board. Instead of re-checking the whole board, the grid is updated 
+ * incrementally: placing or erasing a digit only touches the tile's peers 
+ * (the other tiles in the same row, column and sub-board).
+ *
+ * The candidates are stored as bit mask, where bit #n is set if digit n can
+ * still be placed in the tile.
+ *
+ * The grid also counts how many times each digit occurs in every row, column
+ * and sub-board. A tile is in conflict if its digit occurs more than once in
+ * one of its units. The conflicting tiles are tracked along with the 
+ * candidates, so they can be queried without rescanning the board.
+ */
+
+#ifndef __SUDOKUCANDIDATEGRID_H_
+#define __SUDOKUCANDIDATEGRID_H_
+
+#include <vector>
+#include "bitboard.h"
+
+class SudokuCandidateGrid {
+public:
+    ///
+    /// \brief Init the candidate grid
+    ///
+    /// \param board     The sudoku board
+    /// \param boardSize The no of column (and row) of the board
+    ///
+    SudokuCandidateGrid(std::vector<unsigned int> *board     = NULL,
+                        unsigned int               boardSize = 0
+    );
+
+    ///
+    /// \brief Recalculate all candidates from the board
+    ///
+    /// This should be called once the puzzle is loaded into the board. 
+    ///
+    void rebuild();
+
+    ///
+    /// \brief Update the candidates after a digit is placed / erased
+    ///
+    /// Only the tile and its peers are recalculated.
+    ///
+    /// \param digit  The new digit of the tile (0 to erase the tile)
+    /// \param row    The row of the tile
+    /// \param column The column of the tile
+    ///
+    void setDigit(unsigned int digit, int row, int column);
+
+    ///
+    /// \brief Get the candidates of the tile
+    ///
+    /// \param row    The row of the tile
+    /// \param column The column of the tile
+    ///
+    /// \return The candidate mask (bit #n is set if digit n is available). 
+    ///         Filled tile has no candidates.
+    ///
+    unsigned int candidateMask(int row, int column) const {
+        return _candidates[(row * _boardSize) + column];
+    }
+
+    ///
+    /// \brief Get the digits that can be placed in the tile
+    ///
+    /// Unlike candidateMask(), the tile may already be filled. Its own digit
+    /// is not counted, so the result is the digits that the tile can be 
+    /// changed into without conflicting with its peers.
+    ///
+    /// \param row    The row of the tile
+    /// \param column The column of the tile
+    ///
+    /// \return The digit mask (bit #n is set if digit n is available)
+    ///
+    unsigned int availableDigitMask(int row, int column) const;
+
+    ///
+    /// \brief Check whether the tile has exactly one candidate
+    ///
+    /// \param row    The row of the tile
+    /// \param column The column of the tile
+    ///
+    /// \return true if the tile has only one candidate left
+    ///
+    bool hasSingleCandidate(int row, int column) const {
+        return _candidateCountTiles[1].test((row * _boardSize) + column);
+    }
+
+    ///
+    /// \brief Get the number of tiles with exactly one candidate
+    ///
+    /// \return The number of tiles with single candidate
+    ///
+    unsigned int singleCandidateCount() const {
+        return _candidateCountTiles[1].count();
+    }
+
+    ///
+    /// \brief Get the tiles with exactly one candidate
+    ///
+    /// \return The set of tiles with single candidate
+    ///
+    const Bitboard &singleCandidateTiles() const {
+        return _candidateCountTiles[1];
+    }
+
+    //-------------------------------------------------------------------------
+    // These functions are needed to navigate the board. The search starts 
+    // after the tile in row, column and rolls over to the first tile. The
+    // result is the tile index (row * boardSize + column), or -1 if there is
+    // no such tile.
+
+    ///
+    /// \brief Find the next empty tile
+    ///
+    /// \param row    The row of the tile where the search starts
+    /// \param column The column of the tile where the search starts
+    ///
+    /// \return The next empty tile
+    ///
+    int nextEmptyTile(int row, int column) const;
+
+    ///
+    /// \brief Find the next empty tile with the fewest candidates
+    ///
+    /// Tiles without any candidate left (dead end) are not included.
+    ///
+    /// \param row    The row of the tile where the search starts
+    /// \param column The column of the tile where the search starts
+    ///
+    /// \return The next tile with the fewest candidates
+    ///
+    int nextFewestCandidateTile(int row, int column) const;
+
+    ///
+    /// \brief Find the next empty tile that accepts the digit
+    ///
+    /// \param digit  The digit to be placed
+    /// \param row    The row of the tile where the search starts
+    /// \param column The column of the tile where the search starts
+    ///
+    /// \return The next tile that has the digit as candidate
+    ///
+    int nextTileAccepting(unsigned int digit, int row, int column) const;
+
+    ///
+    /// \brief Get the no of column (and row) of the board
+    ///
+    /// \return The board size
+    ///
+    unsigned int boardSize() const {
+        return _boardSize;
+    }
+
+    ///
+    /// \brief Get the version of the candidates
+    ///
+    /// The version is increased everytime the candidates are changed, so the
+    /// views can skip the update when nothing has changed.
+    ///
+    /// \return The candidate version
+    ///
+    unsigned int version() const {
+        return _version;
+    }
+
+    ///
+    /// \brief Check whether the tile's digit is in conflict with its peers
+    ///
+    /// \param row    The row of the tile
+    /// \param column The column of the tile
+    ///
+    /// \return true if the same digit is placed in the tile's row, column or
+    ///         sub-board
+    ///
+    bool isInConflict(int row, int column) const {
+        return _conflictTiles.test((row * _boardSize) + column);
+    }
+
+    ///
+    /// \brief Get the number of tiles in conflict
+    ///
+    /// \return The number of tiles in conflict
+    ///
+    unsigned int conflictCount() const {
+        return _conflictTiles.count();
+    }
+
+    ///
+    /// \brief Get the tiles in conflict
+    ///
+    /// \return The set of tiles in conflict
+    ///
+    const Bitboard &conflictTiles() const {
+        return _conflictTiles;
+    }
+
+private:
+    ///
+    /// \brief Recalculate the candidates of a single tile
+    ///
+    /// \param tile The tile index (row * boardSize + column)
+    ///
+    void updateCandidate(unsigned int tile);
+
+    ///
+    /// \brief Recalculate the conflict state of a single tile
+    ///
+    /// \param tile The tile index (row * boardSize + column)
+    ///
+    void updateConflict(unsigned int tile);
+
+    ///
+    /// \brief Count the digit in the tile's row, column and sub-board
+    ///
+    /// \param tile  The tile index (row * boardSize + column)
+    /// \param digit The digit to be counted (must not be 0)
+    ///
+    void addDigit(unsigned int tile, unsigned int digit);
+
+    ///
+    /// \brief Uncount the digit from the tile's row, column and sub-board
+    ///
+    /// \param tile  The tile index (row * boardSize + column)
+    /// \param digit The digit to be uncounted (must not be 0)
+    ///
+    void removeDigit(unsigned int tile, unsigned int digit);
+
+    ///
+    /// \brief Pointer to the sudoku board
+    ///
+    std::vector<unsigned int> *_sudokuBoard;
+
+    ///
+    /// \brief The no of column (and row) of the board
+    ///
+    unsigned int _boardSize;
+
+    ///
+    /// \brief The no of column (and row) of the sub-board
+    ///
+    unsigned int _subboardSize;
+
+    ///
+    /// \brief The mask with all digits of the board set
+    ///
+    unsigned int _allDigits;
+
+    ///
+    /// \brief The digit that is currently placed in each tile
+    ///
+    std::vector<unsigned int> _tileDigit;
+
+    ///
+    /// \brief The candidate mask of each tile
+    ///
+    std::vector<unsigned int> _candidates;
+
+    ///
+    /// \brief The occurrence of each digit in each row / column / sub-board.
+    ///        Digit n in unit u is stored at (u * (_boardSize + 1)) + n
+    ///
+    std::vector<unsigned int> _rowCount;
+    std::vector<unsigned int> _columnCount;
+    std::vector<unsigned int> _subboardCount;
+
+    ///
+    /// \brief The digits that are used in each row / column / sub-board
+    ///
+    std::vector<unsigned int> _rowDigits;
+    std::vector<unsigned int> _columnDigits;
+    std::vector<unsigned int> _subboardDigits;
+
+    ///
+    /// \brief The row / column / sub-board of each tile
+    ///
+    std::vector<unsigned int> _tileRow;
+    std::vector<unsigned int> _tileColumn;
+    std::vector<unsigned int> _tileSubboard;
+
+    ///
+    /// \brief The peers of each tile. Tile n's peers are stored starting at
+    ///        (n * _peerCount)
+    ///
+    std::vector<unsigned int> _peers;
+
+    ///
+    /// \brief The no of peers for each tile
+    ///
+    unsigned int _peerCount;
+
+    ///
+    /// \brief The number of candidates of each tile (-1 for filled tile)
+    ///
+    std::vector<int> _tileCandidateCount;
+
+    ///
+    /// \brief The empty tiles
+    ///
+    Bitboard _emptyTiles;
+
+    ///
+    /// \brief The empty tiles, grouped by their number of candidates. The 
+    ///        tiles with n candidates are stored at index n
+    ///
+    std::vector<Bitboard> _candidateCountTiles;
+
+    ///
+    /// \brief The tiles that have digit n as candidate, stored at index n
+    ///
+    std::vector<Bitboard> _digitTiles;
+
+    ///
+    /// \brief The tiles whose digit is in conflict with its peers
+    ///
+    Bitboard _conflictTiles;
+
+    ///
+    /// \brief The candidate version, increased on every change
+    ///
+    unsigned int _version;
+};
+
+#endif // __SUDOKUCANDIDATEGRID_H_
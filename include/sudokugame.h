@@ -30,6 +30,7 @@
 #define __SUDOKUGAME_H_
 
 #include <vector>
+#include "sudokucandidategrid.h"
 
 class SudokuGame {
 public:
@@ -69,12 +70,51 @@ public:
     std::vector<unsigned int> availableDigit(int row, int column);
 
     ///
-    /// \brief Check if all tiles has been filled (game over condition)
+    /// \brief Check the available digit for the row, column, without 
+    ///        allocating any memory
+    ///
+    /// \param row    The row of the tile
+    /// \param column The column of the tile
+    ///
+    /// \return Bit mask of available digit for the tile (bit #n is set if 
+    ///         digit n is available)
+    ///
+    unsigned int availableDigitMask(int row, int column) const;
+
+    ///
+    /// \brief Check if all tiles has been filled without any conflict (game
+    ///        over condition)
     ///
     /// \return true if the game is over
     ///
     bool isGameOver();
 
+    ///
+    /// \brief Update the candidates after the tile in row, column has been
+    ///        changed in the board
+    ///
+    /// This should be called everytime a digit is placed / erased in the 
+    /// board, so the candidates are kept up to date without rescanning the
+    /// whole board.
+    ///
+    /// \param row    The row of the tile
+    /// \param column The column of the tile
+    ///
+    void updateTile(int row, int column);
+
+    ///
+    /// \brief Recalculate the candidates after a new puzzle has been loaded 
+    ///        into the board
+    ///
+    void reset();
+
+    ///
+    /// \brief Get the candidate grid of the board
+    ///
+    /// \return The candidate grid
+    ///
+    const SudokuCandidateGrid *candidateGrid() const;
+
 private:
     ///
     /// \brief Check if the current row is valid
@@ -110,6 +150,11 @@ private:
     /// \brief Pointer to the sudoku board
     ///
     std::vector<unsigned int> *_sudokuBoard;
+
+    ///
+    /// \brief The candidates of each tile in the board
+    ///
+    SudokuCandidateGrid _candidateGrid;
 };
 
 #endif // __SUDOKUGAME_H_
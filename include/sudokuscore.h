@@ -52,10 +52,16 @@ public:
     ///
     void updateScore(int row, int col);
 
+    ///
+    /// \brief Clear the scores, and restart the countdown for a new game
+    ///
+    void reset();
+
     //-------------------------------------------------------------------------
     // AbstractViewer's methods
     virtual void update(sf::Time elapsedTime);
-    virtual void draw(sf::RenderWindow *win);
+    virtual void draw(SpriteBatch *batch);
+    virtual sf::Time timeToNextUpdate();
 
     ///
     /// \brief Get the total score of the board
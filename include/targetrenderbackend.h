@@ -0,0 +1,60 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Render backend that draws the commands into an SFML render target (the 
+ * window or a render texture)
+ */
+
+#ifndef __TARGETRENDERBACKEND_H_
+#define __TARGETRENDERBACKEND_H_
+
+#include "abstractrenderbackend.h"
+
+class TargetRenderBackend : public AbstractRenderBackend {
+public:
+    ///
+    /// \brief Create the backend for the render target
+    ///
+    /// \param target The render target
+    ///
+    explicit TargetRenderBackend(sf::RenderTarget *target = NULL);
+
+    //-------------------------------------------------------------------------
+    // Override the AbstractRenderBackend's methods
+    virtual void drawQuads(const sf::Vertex    *vertex, 
+                           unsigned int         vertexCount,
+                           const sf::Texture   *texture,
+                           const sf::Shader    *shader,
+                           const sf::Transform &transform);
+    virtual void updateTexture(sf::Texture     *texture, 
+                               const sf::Uint8 *pixels);
+
+private:
+    ///
+    /// \brief The render target
+    ///
+    sf::RenderTarget *_target;
+};
+
+#endif // __TARGETRENDERBACKEND_H_
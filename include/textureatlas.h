@@ -0,0 +1,100 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Texture atlas. All of the game artwork is packed into a single texture at 
+ * the game start, so the game can draw everything without switching texture.
+ * Each image is looked up by its file name to get its region in the atlas.
+ */
+
+#ifndef __TEXTUREATLAS_H_
+#define __TEXTUREATLAS_H_
+
+#include <string>
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+///
+/// \brief Pack the images into the atlas texture
+///
+/// The images are packed in rows (shelves), from the tallest to the 
+/// shortest. Images that can't be loaded or don't fit into the atlas are 
+/// left out, and have to be loaded as separate textures.
+///
+/// \param filenames The image file names
+///
+/// \return true if the atlas texture is created
+///
+bool TextureAtlas_build(const std::vector<std::string> &filenames);
+
+///
+/// \brief Create the empty atlas texture, and place the images in it
+///
+/// Used to fill the atlas in several steps, e.g. when the images are 
+/// decoded in the background. The images are only found in the atlas after
+/// they have been uploaded with TextureAtlas_upload(). Images that don't fit
+/// into the atlas are left out.
+///
+/// \param filenames The image file names
+/// \param sizes     The image sizes, in the same order as the file names
+///
+/// \return true if the atlas texture is created
+///
+bool TextureAtlas_pack(const std::vector<std::string>  &filenames,
+                       const std::vector<sf::Vector2u> &sizes);
+
+///
+/// \brief Copy the image into its place in the atlas texture
+///
+/// \param filename The image file name
+/// \param image    The decoded image
+///
+/// \return false if the image has no place in the atlas
+///
+bool TextureAtlas_upload(const std::string &filename, 
+                         const sf::Image   &image);
+
+///
+/// \brief Find the image in the atlas
+///
+/// \param filename The image file name
+/// \param region   Output: The image region in the atlas texture
+///
+/// \return The atlas texture, or NULL if the image is not in the atlas
+///
+const sf::Texture *TextureAtlas_find(const std::string &filename,
+                                     sf::IntRect       *region);
+
+///
+/// \brief Get the atlas texture
+///
+/// \return The atlas texture, or NULL if the atlas hasn't been built
+///
+const sf::Texture *TextureAtlas_texture();
+
+///
+/// \brief Release the atlas texture and its lookup table
+///
+void TextureAtlas_destroy();
+
+#endif // __TEXTUREATLAS_H_
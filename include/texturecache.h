@@ -0,0 +1,132 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Shared texture cache. Each image file is only loaded (and uploaded to the
+ * graphic card) once, and shared by every SharedTexture that refers to it. 
+ * Images that are packed in the texture atlas use the atlas texture instead,
+ * so the user must draw using the image's region in the texture.
+ * The texture is released when the last SharedTexture is gone, unless it is 
+ * pinned to be kept across game state transitions.
+ *
+ * SharedTexture can be used in any thread. An image that's not in the atlas
+ * is uploaded to the graphic card when it's loaded, so it has to be loaded 
+ * in the game loop's thread first.
+ */
+
+#ifndef __TEXTURECACHE_H_
+#define __TEXTURECACHE_H_
+
+#include <string>
+#include <SFML/Graphics.hpp>
+
+struct TextureCacheEntry;
+
+///
+/// \brief Keep the texture loaded even when nobody is using it
+///
+/// The texture is loaded immediately if it's not in the cache yet.
+///
+/// \param filename The texture file name
+///
+void TextureCache_pin(const std::string &filename);
+
+///
+/// \brief Allow the texture to be released when nobody is using it
+///
+/// \param filename The texture file name
+///
+void TextureCache_unpin(const std::string &filename);
+
+///
+/// \brief Unpin all of the pinned textures
+///
+void TextureCache_unpinAll();
+
+///
+/// \brief Get the no of textures in the cache
+///
+/// \return The no of textures in the cache
+///
+unsigned int TextureCache_textureCount();
+
+///
+/// \brief Get the graphic memory held by the textures in the cache
+///
+/// \return The graphic memory (in bytes), assuming 4 bytes per pixel
+///
+unsigned int TextureCache_memoryUsage();
+
+class SharedTexture {
+public:
+    ///
+    /// \brief Get the texture from the cache, load it if it's not there yet
+    ///
+    /// \param filename The texture file name. Empty file name means no 
+    ///                 texture
+    ///
+    explicit SharedTexture(const std::string &filename = "");
+
+    SharedTexture(const SharedTexture &other);
+
+    SharedTexture &operator=(const SharedTexture &other);
+
+    ~SharedTexture();
+
+    ///
+    /// \brief Get the texture
+    ///
+    /// \return The texture, or NULL if there is no texture
+    ///
+    const sf::Texture *get() const;
+
+    ///
+    /// \brief Get the image size
+    ///
+    /// \return The image size in pixel, or (0, 0) if there is no texture
+    ///
+    sf::Vector2u getSize() const;
+
+    ///
+    /// \brief Get the image's top-left corner in the texture
+    ///
+    /// \return The image offset in pixel, (0, 0) if the image has its own 
+    ///         texture
+    ///
+    sf::Vector2u getOffset() const;
+
+    ///
+    /// \brief Get the image region in the texture
+    ///
+    /// \return The image region in the texture
+    ///
+    sf::IntRect getRegion() const;
+
+private:
+    ///
+    /// \brief The texture in the cache
+    ///
+    TextureCacheEntry *_entry;
+};
+
+#endif // __TEXTURECACHE_H_
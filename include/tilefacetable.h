@@ -0,0 +1,97 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+/*
+ * Precalculated texture coordinates of every tile (face) in a tilemap. The 
+ * table only depends on the tilemap size, the tile size and the tilemap 
+ * position in the texture, so one table is shared by every view that uses the
+ * same kind of tilemap.
+ */
+
+#ifndef __TILEFACETABLE_H_
+#define __TILEFACETABLE_H_
+
+#include <vector>
+#include <SFML/Graphics.hpp>
+
+class TileFaceTable {
+public:
+    ///
+    /// \brief Get the shared face table for the tilemap
+    ///
+    /// The table is created on the first request, and kept until the game 
+    /// exits.
+    ///
+    /// \param tilemapSize   Tilemap size in pixel
+    /// \param tileSize      The size of each tile in tilemap
+    /// \param tilemapOffset The tilemap's top-left corner in the texture
+    ///
+    /// \return The face table
+    ///
+    static const TileFaceTable *get(
+        sf::Vector2u tilemapSize, 
+        sf::Vector2u tileSize,
+        sf::Vector2u tilemapOffset = sf::Vector2u(0, 0)
+    );
+
+    ///
+    /// \brief Get the texture coordinates of the face
+    ///
+    /// \param face The tile no in tilemap
+    ///
+    /// \return The 4 texture coordinates (top-left, top-right, bottom-right,
+    ///         bottom-left) of the face
+    ///
+    const sf::Vector2f *texCoords(int face) const {
+        if ((face < 0) || ((unsigned int) face >= _faceCount)) {
+            // Unknown face, use the first tile instead
+            face = 0;
+        }
+
+        return &_texCoords[face * 4];
+    }
+
+private:
+    ///
+    /// \brief Calculate the face table
+    ///
+    /// \param tilemapSize   Tilemap size in pixel
+    /// \param tileSize      The size of each tile in tilemap
+    /// \param tilemapOffset The tilemap's top-left corner in the texture
+    ///
+    TileFaceTable(sf::Vector2u tilemapSize, 
+                  sf::Vector2u tileSize,
+                  sf::Vector2u tilemapOffset);
+
+    ///
+    /// \brief The no of faces in the tilemap
+    ///
+    unsigned int _faceCount;
+
+    ///
+    /// \brief The texture coordinates, 4 for each face
+    ///
+    std::vector<sf::Vector2f> _texCoords;
+};
+
+#endif // __TILEFACETABLE_H_
@@ -22,25 +22,29 @@
  */
 
 /* 
- * Store the tile's information (its graphic properties)
+ * Store the tile's information (its graphic properties). The tile doesn't own
+ * its vertex, it writes its 4 corners into the owner's vertex buffer.
  */
 
 #ifndef __TILEVIEW_H_
 #define __TILEVIEW_H_
 
-#include <vector>
 #include <SFML/Graphics.hpp>
+#include "tilefacetable.h"
 
 class TileView {
 public:
     ///
     /// \brief Create tile, with _tilePos = (0, 0)
     ///
-    /// \param tilemapSize Tilemap size in pixel
-    /// \param tileSize    The size of each tile in tilemap
+    /// \param tilemapSize   Tilemap size in pixel
+    /// \param tileSize      The size of each tile in tilemap
+    /// \param tilemapOffset The tilemap's top-left corner in the texture 
+    ///                      (when the tilemap is part of a texture atlas)
     ///
-    TileView(sf::Vector2u tilemapSize = sf::Vector2u(1, 1), 
-             sf::Vector2u tileSize    = sf::Vector2u(1, 1)
+    TileView(sf::Vector2u tilemapSize   = sf::Vector2u(1, 1), 
+             sf::Vector2u tileSize      = sf::Vector2u(1, 1),
+             sf::Vector2u tilemapOffset = sf::Vector2u(0, 0)
     );
 
     ///
@@ -49,7 +53,10 @@ public:
     /// \param face The tile no in tilemap
     ///
     void setFace(int face) {
-        _tileFace = face;
+        if (_tileFace != face) {
+            _tileFace = face;
+            _isDirty  = true;
+        }
     }
 
     ///
@@ -69,33 +76,32 @@ public:
     /// \param position The tile's new position in screen
     ///
     void setPosition(sf::Vector2f position) {
-        _tilePos = position;
+        if (_tilePos != position) {
+            _tilePos = position;
+            _isDirty = true;
+        }
+    }
+
+    ///
+    /// \brief Check whether the tile's face / position has been changed 
+    ///        since the last update()
+    ///
+    /// \return true if the tile's vertex need to be updated
+    ///
+    bool isDirty(void) const {
+        return _isDirty;
     }
 
     //-------------------------------------------------------------------------
-    // Interface to get the Vertex of this tile to be drawn in the screen
+    // Interface to write the Vertex of this tile to be drawn in the screen
     
     ///
     /// \brief Adjust tile's texture to match the value, and its 4  corners to 
     ///        fit the new position on the screen
     ///
-    void update(sf::Time elapsedTime);
-
-    std::vector<sf::Vertex>::iterator begin() {
-        return _vertex.begin();
-    }
-
-    std::vector<sf::Vertex>::iterator end() {
-        return _vertex.end();
-    }
-
-    std::vector<sf::Vertex>::const_iterator begin() const {
-        return _vertex.begin();
-    }
-
-    std::vector<sf::Vertex>::const_iterator end() const {
-        return _vertex.end();
-    }
+    /// \param vertex The 4 vertex (quad) to be written with the tile's value
+    ///
+    void update(sf::Vertex *vertex);
 
 private:
     ///
@@ -109,9 +115,9 @@ private:
     sf::Vector2f _tilePos;
 
     ///
-    /// \brief The tilemap size in pixel
+    /// \brief The texture coordinates of each face in the tilemap
     ///
-    sf::Vector2u _tilemapSize;
+    const TileFaceTable *_faceTable;
 
     ///
     /// \brief The tile size (in pixel)
@@ -119,9 +125,9 @@ private:
     sf::Vector2u _tileSize;
 
     ///
-    /// \brief The vertex to draw the tile
+    /// \brief Flag to indicate that the vertex need to be updated
     ///
-    std::vector<sf::Vertex> _vertex;
+    bool _isDirty;
 };
 
 #endif // __TILEVIEW_H_
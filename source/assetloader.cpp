@@ -0,0 +1,181 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <SFML/Graphics.hpp>
+#include "assetloader.h"
+#include "embeddedartwork.h"
+#include "jobsystem.h"
+#include "textureatlas.h"
+
+///
+/// \brief The no of images that are uploaded into the atlas per frame
+///
+#define ASSETLOADER_UPLOADS_PER_FRAME   2
+
+//-----------------------------------------------------------------------------
+///
+/// \brief The image to be loaded
+///
+struct AssetLoaderImage {
+    std::string filename;
+    sf::Image   image;
+    bool        isDecoded;
+};
+
+///
+/// \brief The images to be loaded, in the order they're uploaded
+///
+static std::vector<AssetLoaderImage> _images;
+
+///
+/// \brief The no of images that have finished decoding (or failed)
+///
+static unsigned int _decodedCount = 0;
+
+///
+/// \brief The no of images that have been uploaded (or skipped)
+///
+static unsigned int _uploadedCount = 0;
+
+///
+/// \brief Flag to indicate that the atlas has been packed
+///
+static bool _isPacked = false;
+
+///
+/// \brief Flag to indicate that all of the images have been loaded
+///
+static bool _isFinished = true;
+
+//-----------------------------------------------------------------------------
+///
+/// \brief Decode a single image in a worker thread
+///
+class AssetDecodeJob : public AbstractJob {
+public:
+    AssetDecodeJob(unsigned int index, const std::string &filename) :
+        _index(index),
+        _filename(filename),
+        _isDecoded(false)
+    {
+    }
+
+    virtual void run() {
+        _isDecoded = EmbeddedArtwork_loadImage(_filename, &_image);
+    }
+
+    virtual void complete() {
+        if (_isDecoded) {
+            _images[_index].image     = _image;
+            _images[_index].isDecoded = true;
+        }
+
+        _decodedCount++;
+    }
+
+private:
+    unsigned int _index;
+    std::string  _filename;
+    sf::Image    _image;
+    bool         _isDecoded;
+};
+
+//-----------------------------------------------------------------------------
+void AssetLoader_start(const std::vector<std::string> &filenames) {
+    _images.clear();
+    _images.resize(filenames.size());
+
+    _decodedCount  = 0;
+    _uploadedCount = 0;
+    _isPacked      = false;
+    _isFinished    = false;
+
+    for (unsigned int i = 0; i < filenames.size(); i++) {
+        _images[i].filename  = filenames[i];
+        _images[i].isDecoded = false;
+
+        // All of the images are decoded in parallel
+        JobSystem_submit(new AssetDecodeJob(i, filenames[i]), 
+                         JOB_PRIORITY_HIGH);
+    }
+}
+
+bool AssetLoader_update() {
+    if (_isFinished) {
+        return true;
+    }
+
+    if (_decodedCount < _images.size()) {
+        // Still decoding
+        return false;
+    }
+
+    if (!_isPacked) {
+        // All of the image sizes are known now
+        std::vector<std::string>  filenames;
+        std::vector<sf::Vector2u> sizes;
+
+        for (unsigned int i = 0; i < _images.size(); i++) {
+            if (_images[i].isDecoded) {
+                filenames.push_back(_images[i].filename);
+                sizes.push_back(_images[i].image.getSize());
+            }
+        }
+
+        _isPacked = true;
+
+        if (!TextureAtlas_pack(filenames, sizes)) {
+            // The images are loaded as separate textures when they're used
+            _uploadedCount = _images.size();
+        }
+
+        // Uploading starts on the next frame
+        return false;
+    }
+
+    for (unsigned int i = 0; 
+         (i < ASSETLOADER_UPLOADS_PER_FRAME) && 
+         (_uploadedCount < _images.size()); i++) {
+        AssetLoaderImage *image = &_images[_uploadedCount];
+
+        if (image->isDecoded) {
+            TextureAtlas_upload(image->filename, image->image);
+        }
+
+        _uploadedCount++;
+    }
+
+    if (_uploadedCount < _images.size()) {
+        return false;
+    }
+
+    // The decoded images are in the atlas now
+    _images.clear();
+    _isFinished = true;
+
+    return true;
+}
+
+bool AssetLoader_isFinished() {
+    return _isFinished;
+}
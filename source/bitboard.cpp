@@ -0,0 +1,65 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "bitboard.h"
+
+Bitboard::Bitboard(unsigned int size) :
+    _words((size + BITBOARD_WORD_BITS - 1) / BITBOARD_WORD_BITS, 0),
+    _size(size),
+    _count(0)
+{
+}
+
+void Bitboard::clear() {
+    for (unsigned int i = 0; i < _words.size(); i++) {
+        _words[i] = 0;
+    }
+
+    _count = 0;
+}
+
+int Bitboard::findNext(unsigned int from) const {
+    if ((_count == 0) || (_size == 0)) {
+        return -1;
+    }
+
+    from = from % _size;
+
+    unsigned int wordNo = from / BITBOARD_WORD_BITS;
+
+    // Ignore the tiles before 'from' in the first word. They are checked 
+    // last, once the search has rolled over.
+    unsigned int word = _words[wordNo] & 
+                        ~((1u << (from % BITBOARD_WORD_BITS)) - 1);
+
+    for (unsigned int i = 0; i <= _words.size(); i++) {
+        if (word != 0) {
+            return (int) ((wordNo * BITBOARD_WORD_BITS) + lowestBit(word));
+        }
+
+        wordNo = (wordNo + 1) % _words.size();
+        word   = _words[wordNo];
+    }
+
+    return -1;
+}
@@ -63,6 +63,10 @@ sf::Vector2f BoardLayout::tilePositionInScreen(int row, int column) {
     return tilePos;
 }
 
+sf::Transform BoardLayout::screenTransform() {
+    return sf::Transform::Identity;
+}
+
 sf::Vector2u BoardLayout::tileSize() const {
     return _tileSize;
 }
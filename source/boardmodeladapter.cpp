@@ -29,7 +29,8 @@ BoardModelAdapter::BoardModelAdapter(std::vector<unsigned int> *model,
     _modelMask(NULL), 
     _columnSize(columnSize), 
     _rowSize(0), 
-    _maskIsEnabled(false)
+    _maskIsEnabled(false),
+    _version(0)
 {
     calculateRowSize();
 }
@@ -40,11 +41,13 @@ BoardModelAdapter::~BoardModelAdapter() {
 void BoardModelAdapter::setModel(std::vector<unsigned int> *model) {
     _model = model;
     calculateRowSize();
+    markChanged();
 }
 
 void BoardModelAdapter::setModelMask(std::vector<bool> *modelMask) {
     _modelMask = modelMask;
     enableMask();
+    markChanged();
 }
 
 void BoardModelAdapter::enableMask() {
@@ -55,6 +58,14 @@ void BoardModelAdapter::disableMask() {
     _maskIsEnabled = false;
 }
 
+void BoardModelAdapter::markChanged() {
+    _version++;
+}
+
+unsigned int BoardModelAdapter::version() {
+    return _version;
+}
+
 unsigned int BoardModelAdapter::size() {
     return _model->size();
 }
@@ -80,15 +91,31 @@ unsigned int BoardModelAdapter::value(int row, int column) {
     }
 }
 
+unsigned int BoardModelAdapter::unmaskedValue(int row, int column) {
+    return (*_model)[(row * _columnSize) + column];
+}
+
+bool BoardModelAdapter::tileIsMasked(int row, int column) {
+    if (_modelMask == NULL) {
+        return false;
+    }
+
+    return (*_modelMask)[(row * _columnSize) + column];
+}
+
 void BoardModelAdapter::setValue(unsigned int value, int row, int column) {
+    unsigned int *tile = &(*_model)[(row * _columnSize) + column];
+
     if (_maskIsEnabled) {
-        if ((*_modelMask)[(row * _columnSize) + column] == false) {
-            (*_model)[(row * _columnSize) + column] = value;
-        } else {
+        if ((*_modelMask)[(row * _columnSize) + column] == true) {
             // The tile is masked. Ignore the setValue request
+            return;
         }
-    } else {
-        (*_model)[(row * _columnSize) + column] = value;
+    }
+
+    if (*tile != value) {
+        *tile = value;
+        markChanged();
     }
 }
 
@@ -22,53 +22,94 @@
  */
 
 #include "boardview.h"
+#include "dirtyregion.h"
 
 BoardView::BoardView(BoardModelAdapter *board,
                      BoardLayout       *layout,
                      const std::string &tilemapFilename) :
-    _board(board) 
+    _board(board),
+    _vertexCount(0),
+    _boardVersion(0),
+    _tilesAreDirty(true)
 {
     // Load the tile texture
-    _tileTexture.loadFromFile(tilemapFilename);
+    _tileTexture = SharedTexture(tilemapFilename);
 
     if ((board == NULL) || (layout == NULL)) {
         return;
     }
 
     for (unsigned int i = 0; i < _board->size(); i++) {
-        TileView tile(_tileTexture.getSize(), layout->tileSize());
+        TileView tile(_tileTexture.getSize(), 
+                      layout->tileSize(), 
+                      _tileTexture.getOffset());
         _boardTiles.push_back(tile);
     }
 
-    // Setup the layout of the board
+    // Setup the layout of the board. The tiles stay in the board's space,
+    // the layout's transform fits them to the screen when they're drawn.
     layout->setTileLayout(&_boardTiles);
+    _transform = layout->screenTransform();
+
+    // Each tile requires 4 Vertex points
+    _vertex.resize(_boardTiles.size() * 4);
+
+    // Force the first update to read the whole board
+    _boardVersion = _board->version() - 1;
 }
 
 void BoardView::update(sf::Time elapsedTime) {
-    _vertex.clear();
+    if ((_board != NULL) && (_boardVersion != _board->version())) {
+        // The model has changed. Only the tiles with different face will be
+        // marked as dirty.
+        unsigned int tileCount = 0;
 
-    for (unsigned int row = 0; row < _board->rowSize(); row++) {
-        for (unsigned int col = 0; col < _board->columnSize(); col++) {
-            if (_board->tileIsInBoard(row, col)) {
-                TileView *tile = 
-                    &_boardTiles[(row * _board->columnSize()) + col];
+        for (unsigned int row = 0; row < _board->rowSize(); row++) {
+            for (unsigned int col = 0; col < _board->columnSize(); col++) {
+                unsigned int tileNo = (row * _board->columnSize()) + col;
 
-                tile->setFace(_board->value(row, col));
-                tile->update(elapsedTime);
-                _vertex.insert( _vertex.end(), tile->begin(), tile->end());
+                if ((_board->tileIsInBoard(row, col)) && 
+                    (tileNo < _boardTiles.size())) {
+                    _boardTiles[tileNo].setFace(_board->value(row, col));
+                    tileCount = tileNo + 1;
+                }
             }
         }
+
+        _vertexCount   = tileCount * 4;
+        _boardVersion  = _board->version();
+        _tilesAreDirty = true;
+    }
+
+    if (!_tilesAreDirty) {
+        // Nothing has changed since the last update
+        return;
     }
+
+    for (unsigned int i = 0; i < _boardTiles.size(); i++) {
+        TileView *tile = &_boardTiles[i];
+
+        if (tile->isDirty()) {
+            // The tile writes its quad straight into the board's vertex. Both
+            // the old and the new quad have to be redrawn.
+            DirtyRegion_addQuad(&_vertex[i * 4], _transform);
+            tile->update(&_vertex[i * 4]);
+            DirtyRegion_addQuad(&_vertex[i * 4], _transform);
+        }
+    }
+
+    _tilesAreDirty = false;
 }
 
-void BoardView::draw(sf::RenderWindow *win) {
+void BoardView::draw(SpriteBatch *batch) {
     // Don't draw if it's not supposed to be shown
-    if (!_isShowed) {
+    if ((!_isShowed) || (_vertexCount == 0)) {
         return;
     }
 
-    win->draw(&_vertex[0], 
-              _vertex.size(), 
-              sf::Quads, 
-              &_tileTexture);
+    batch->draw(&_vertex[0], 
+                _vertexCount, 
+                _tileTexture.get(), 
+                _layer,
+                _transform);
 }
@@ -0,0 +1,81 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "capturerenderbackend.h"
+
+CaptureRenderBackend::CaptureRenderBackend(std::ostream *stream) :
+    _stream(stream)
+{
+}
+
+void CaptureRenderBackend::drawQuads(const sf::Vertex    *vertex, 
+                                     unsigned int         vertexCount,
+                                     const sf::Texture   *texture,
+                                     const sf::Shader    *shader,
+                                     const sf::Transform &transform) {
+    if (_stream == NULL) {
+        return;
+    }
+
+    // The 2D part of the 4x4 transform matrix
+    const float *matrix = transform.getMatrix();
+
+    *_stream << "quads " << resourceId(texture, &_textureIds)
+             << " "      << resourceId(shader,  &_shaderIds)
+             << " "      << matrix[0] << " " << matrix[4]
+             << " "      << matrix[1] << " " << matrix[5]
+             << " "      << matrix[12] << " " << matrix[13]
+             << " "      << vertexCount;
+
+    for (unsigned int i = 0; i < vertexCount; i++) {
+        *_stream << " " << vertex[i].position.x 
+                 << " " << vertex[i].position.y
+                 << " " << (unsigned int) vertex[i].color.r
+                 << " " << (unsigned int) vertex[i].color.g
+                 << " " << (unsigned int) vertex[i].color.b
+                 << " " << (unsigned int) vertex[i].color.a
+                 << " " << vertex[i].texCoords.x
+                 << " " << vertex[i].texCoords.y;
+    }
+
+    *_stream << "\n";
+}
+
+unsigned int CaptureRenderBackend::resourceId(
+    const void                           *resource,
+    std::map<const void *, unsigned int> *ids) {
+    if (resource == NULL) {
+        return 0;
+    }
+
+    std::map<const void *, unsigned int>::iterator it = ids->find(resource);
+
+    if (it != ids->end()) {
+        return it->second;
+    }
+
+    unsigned int id = ids->size() + 1;
+    (*ids)[resource] = id;
+
+    return id;
+}
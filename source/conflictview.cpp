@@ -0,0 +1,124 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "conflictview.h"
+#include "dirtyregion.h"
+
+ConflictView::ConflictView(const SudokuCandidateGrid *grid,
+                           BoardLayout               *layout,
+                           sf::Color                  highlightColor) :
+    _grid(grid),
+    _highlightColor(highlightColor),
+    _gridVersion(0)
+{
+    if ((grid == NULL) || (layout == NULL)) {
+        return;
+    }
+
+    unsigned int boardSize = _grid->boardSize();
+    unsigned int tileCount = boardSize * boardSize;
+
+    _tileSize  = layout->tileSize();
+    _transform = layout->screenTransform();
+
+    for (unsigned int tile = 0; tile < tileCount; tile++) {
+        _tilePosition.push_back(
+            layout->tilePositionInScreen(tile / boardSize, tile % boardSize)
+        );
+    }
+
+    _vertex.resize(tileCount * 4);
+
+    for (unsigned int i = 0; i < _vertex.size(); i++) {
+        _vertex[i].color = _highlightColor;
+    }
+
+    // Start with no highlight, and force the first update to check all tiles
+    _tileInConflict = std::vector<bool> (tileCount, true);
+    for (unsigned int tile = 0; tile < tileCount; tile++) {
+        _tileInConflict[tile] = false;
+        updateTileHighlight(tile);
+    }
+
+    _gridVersion = _grid->version() - 1;
+}
+
+void ConflictView::update(sf::Time elapsedTime) {
+    if ((_grid == NULL) || (_gridVersion == _grid->version())) {
+        // The conflicts haven't changed since the last update
+        return;
+    }
+
+    const Bitboard &conflictTiles = _grid->conflictTiles();
+
+    for (unsigned int tile = 0; tile < _tileInConflict.size(); tile++) {
+        if (conflictTiles.test(tile) != _tileInConflict[tile]) {
+            _tileInConflict[tile] = conflictTiles.test(tile);
+            updateTileHighlight(tile);
+
+            DirtyRegion_add(_transform.transformRect(sf::FloatRect(
+                _tilePosition[tile].x - (_tileSize.x / 2.f),
+                _tilePosition[tile].y - (_tileSize.y / 2.f),
+                (float) _tileSize.x,
+                (float) _tileSize.y
+            )));
+        }
+    }
+
+    _gridVersion = _grid->version();
+}
+
+void ConflictView::draw(SpriteBatch *batch) {
+    // Don't draw if it's not supposed to be shown, or nothing is in conflict
+    if ((!_isShowed) || (_vertex.empty()) || (_grid->conflictCount() == 0)) {
+        return;
+    }
+
+    batch->draw(&_vertex[0], 
+                _vertex.size(), 
+                NULL, 
+                _layer,
+                _transform);
+}
+
+void ConflictView::updateTileHighlight(unsigned int tile) {
+    sf::Vertex *vertex = &_vertex[tile * 4];
+
+    if (!_tileInConflict[tile]) {
+        // No conflict, collapse the quad so nothing is drawn
+        for (unsigned int i = 0; i < 4; i++) {
+            vertex[i].position = _tilePosition[tile];
+        }
+        return;
+    }
+
+    float left   = _tilePosition[tile].x - (_tileSize.x / 2.f);
+    float top    = _tilePosition[tile].y - (_tileSize.y / 2.f);
+    float right  = left + _tileSize.x;
+    float bottom = top  + _tileSize.y;
+
+    vertex[0].position = sf::Vector2f( left,    top);
+    vertex[1].position = sf::Vector2f(right,    top);
+    vertex[2].position = sf::Vector2f(right, bottom);
+    vertex[3].position = sf::Vector2f( left, bottom);
+}
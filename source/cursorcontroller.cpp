@@ -32,6 +32,11 @@ CursorController::CursorController(BoardModelAdapter *boardModelAdapter,
     _cursorModel(cursorModel),
     _cursorView(cursorView) 
 {
+    if ((boardLayout != NULL) && (cursorView != NULL)) {
+        // The cursor follows the board when it's scaled to fit the screen
+        _cursorView->setTransform(_boardLayout->screenTransform());
+    }
+
     if (boardModelAdapter == NULL) {
         return;
     }
@@ -114,6 +119,16 @@ void CursorController::resetCursorPosition() {
     updateCursorView();
 }
 
+void CursorController::moveCursorTo(int row, int column) {
+    if (!_boardModelAdapter->tileIsInBoard(row, column)) {
+        return;
+    }
+
+    _cursorModel->x = column;
+    _cursorModel->y = row;
+    updateCursorView();
+}
+
 void CursorController::moveCursorUp() {
     do {
         if (_cursorModel->y > 0) {
@@ -22,37 +22,41 @@
  */
 
 #include "cursorview.h"
+#include "dirtyregion.h"
 
 CursorView::CursorView(sf::Vector2u       cursorSize,
                         const std::string &cursorFilename) {
     // Load cursor texture
-    _cursorTexture.loadFromFile(cursorFilename);
+    _cursorTexture = SharedTexture(cursorFilename);
 
     // Setup the cursor tile. Assuming that the tilemap has only single tile
     // for the cursor only.
-    _cursorTile = TileView(cursorSize, cursorSize);
+    _cursorTile = TileView(cursorSize, cursorSize, _cursorTexture.getOffset());
 }
 
 void CursorView::update(sf::Time elapsedTime) {
-    _cursorTile.update(elapsedTime);
+    if (!_cursorTile.isDirty()) {
+        // The cursor hasn't moved since the last update
+        return;
+    }
 
-    _vertex.clear();
-    _vertex.insert( _vertex.end(), 
-                    _cursorTile.begin(), 
-                    _cursorTile.end()
-    );
+    // Redraw the cursor's old and new position
+    DirtyRegion_addQuad(_vertex, _transform);
+    _cursorTile.update(_vertex);
+    DirtyRegion_addQuad(_vertex, _transform);
 }
 
-void CursorView::draw(sf::RenderWindow *win) {
+void CursorView::draw(SpriteBatch *batch) {
     // Don't draw if it's not supposed to be shown
     if (!_isShowed) {
         return;
     }
 
-    win->draw(&_vertex[0], 
-              _vertex.size(), 
-              sf::Quads, 
-              &_cursorTexture);
+    batch->draw(_vertex, 
+                4, 
+                _cursorTexture.get(), 
+                _layer,
+                _transform);
 }
 
 void CursorView::setPosition(sf::Vector2f position) {
@@ -0,0 +1,152 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "dirtyregion.h"
+
+///
+/// \brief The max no of separate regions. If there are more, all of them are
+///        merged into their bounding box.
+///
+#define DIRTYREGION_MAX_RECTS       8
+
+///
+/// \brief The changed regions, none of them overlaps the other
+///
+static std::vector<sf::IntRect> _dirtyRects;
+
+///
+/// \brief Flag to indicate that the whole screen has changed
+///
+static bool _isAllDirty = true;
+
+///
+/// \brief Protect the changed regions. The views of a game state that's 
+///        constructed in a worker thread report their changes too.
+///
+static sf::Mutex _dirtyRegionMutex;
+
+//-----------------------------------------------------------------------------
+///
+/// \brief Get the smallest rectangle that covers both rectangles
+///
+static sf::IntRect DirtyRegion_union(const sf::IntRect &a, 
+                                     const sf::IntRect &b) {
+    int left   = std::min(a.left, b.left);
+    int top    = std::min(a.top,  b.top);
+    int right  = std::max(a.left + a.width,  b.left + b.width);
+    int bottom = std::max(a.top  + a.height, b.top  + b.height);
+
+    return sf::IntRect(left, top, right - left, bottom - top);
+}
+
+//-----------------------------------------------------------------------------
+void DirtyRegion_add(const sf::FloatRect &rect) {
+    sf::Lock lock(_dirtyRegionMutex);
+
+    if ((_isAllDirty) || (rect.width <= 0) || (rect.height <= 0)) {
+        return;
+    }
+
+    // Round it to the whole pixels that are touched by the region
+    int left   = (int) std::floor(rect.left);
+    int top    = (int) std::floor(rect.top);
+    int right  = (int) std::ceil (rect.left + rect.width);
+    int bottom = (int) std::ceil (rect.top  + rect.height);
+
+    sf::IntRect dirtyRect(left, top, right - left, bottom - top);
+
+    // Merge with the overlapping regions, until nothing overlaps
+    unsigned int i = 0;
+    while (i < _dirtyRects.size()) {
+        if (_dirtyRects[i].intersects(dirtyRect)) {
+            dirtyRect = DirtyRegion_union(dirtyRect, _dirtyRects[i]);
+            _dirtyRects.erase(_dirtyRects.begin() + i);
+            i = 0;
+        } else {
+            i++;
+        }
+    }
+
+    _dirtyRects.push_back(dirtyRect);
+
+    if (_dirtyRects.size() > DIRTYREGION_MAX_RECTS) {
+        // Too many regions, redraw their bounding box instead
+        for (i = 1; i < _dirtyRects.size(); i++) {
+            _dirtyRects[0] = DirtyRegion_union(_dirtyRects[0], _dirtyRects[i]);
+        }
+        _dirtyRects.resize(1);
+    }
+}
+
+void DirtyRegion_addQuad(const sf::Vertex    *quad,
+                         const sf::Transform &transform) {
+    float left   = quad[0].position.x;
+    float top    = quad[0].position.y;
+    float right  = quad[0].position.x;
+    float bottom = quad[0].position.y;
+
+    for (unsigned int i = 1; i < 4; i++) {
+        left   = std::min(left,   quad[i].position.x);
+        top    = std::min(top,    quad[i].position.y);
+        right  = std::max(right,  quad[i].position.x);
+        bottom = std::max(bottom, quad[i].position.y);
+    }
+
+    DirtyRegion_add(transform.transformRect(
+        sf::FloatRect(left, top, right - left, bottom - top)
+    ));
+}
+
+void DirtyRegion_invalidateAll() {
+    sf::Lock lock(_dirtyRegionMutex);
+
+    _isAllDirty = true;
+    _dirtyRects.clear();
+}
+
+bool DirtyRegion_isAllDirty() {
+    sf::Lock lock(_dirtyRegionMutex);
+
+    return _isAllDirty;
+}
+
+bool DirtyRegion_take(std::vector<sf::IntRect> *rects) {
+    sf::Lock lock(_dirtyRegionMutex);
+
+    bool isAllDirty = _isAllDirty;
+    *rects = _dirtyRects;
+
+    _isAllDirty = false;
+    _dirtyRects.clear();
+
+    return isAllDirty;
+}
+
+void DirtyRegion_clear() {
+    sf::Lock lock(_dirtyRegionMutex);
+
+    _isAllDirty = false;
+    _dirtyRects.clear();
+}
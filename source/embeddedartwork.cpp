@@ -0,0 +1,150 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <cstring>
+#include <vector>
+#include "embeddedartwork.h"
+
+#if defined(BORINGSUDOKU_EMBEDDED_ARTWORK)
+// The minimum match length in an LZ4 sequence
+#define EMBEDDEDARTWORK_MIN_MATCH   4
+
+///
+/// \brief Read the extended length bytes of an LZ4 sequence
+///
+/// \param embedded The embedded image
+/// \param pos      The read position, to be advanced
+/// \param length   The length, to be added to
+///
+/// \return false if the data ends before the length
+///
+static bool EmbeddedArtwork_readLength(const EmbeddedArtworkImage *embedded,
+                                       unsigned int               *pos,
+                                       unsigned int               *length) {
+    unsigned int value;
+
+    do {
+        if (*pos >= embedded->dataSize) {
+            return false;
+        }
+
+        value    = embedded->data[(*pos)++];
+        *length += value;
+    } while (value == 255);
+
+    return true;
+}
+
+///
+/// \brief Decompress the image's LZ4 block into RGBA pixels
+///
+/// \param embedded The embedded image
+/// \param pixels   The pixels to be filled
+///
+/// \return false if the block doesn't match the image size
+///
+static bool EmbeddedArtwork_decode(const EmbeddedArtworkImage *embedded,
+                                   std::vector<sf::Uint8>     *pixels) {
+    unsigned int size = embedded->width * embedded->height * 4;
+    unsigned int out  = 0;
+    unsigned int pos  = 0;
+
+    pixels->resize(size);
+
+    while (pos < embedded->dataSize) {
+        unsigned int token         = embedded->data[pos++];
+        unsigned int literalLength = token >> 4;
+        unsigned int matchLength   = token & 0x0F;
+        unsigned int offset;
+
+        // The literals
+        if ((literalLength == 15) && 
+            (!EmbeddedArtwork_readLength(embedded, &pos, &literalLength))) {
+            return false;
+        }
+        if ((literalLength > embedded->dataSize - pos) || 
+            (literalLength > size - out)) {
+            return false;
+        }
+
+        if (literalLength > 0) {
+            std::memcpy(&(*pixels)[out], &embedded->data[pos], literalLength);
+            pos += literalLength;
+            out += literalLength;
+        }
+
+        // The last sequence has no match
+        if (pos == embedded->dataSize) {
+            break;
+        }
+
+        // The match, which may overlap the bytes it produces
+        if (pos + 2 > embedded->dataSize) {
+            return false;
+        }
+        offset = embedded->data[pos] | (embedded->data[pos + 1] << 8);
+        pos   += 2;
+
+        if ((matchLength == 15) && 
+            (!EmbeddedArtwork_readLength(embedded, &pos, &matchLength))) {
+            return false;
+        }
+        matchLength += EMBEDDEDARTWORK_MIN_MATCH;
+
+        if ((offset == 0) || (offset > out) || (matchLength > size - out)) {
+            return false;
+        }
+
+        for (unsigned int i = 0; i < matchLength; i++, out++) {
+            (*pixels)[out] = (*pixels)[out - offset];
+        }
+    }
+
+    return (out == size);
+}
+#endif
+
+//-----------------------------------------------------------------------------
+bool EmbeddedArtwork_loadImage(const std::string &filename, sf::Image *image) {
+#if defined(BORINGSUDOKU_EMBEDDED_ARTWORK)
+    for (unsigned int i = 0; i < _embeddedArtworkCount; i++) {
+        const EmbeddedArtworkImage *embedded = &_embeddedArtwork[i];
+
+        if (filename != embedded->filename) {
+            continue;
+        }
+
+        std::vector<sf::Uint8> pixels;
+        if ((embedded->width == 0) || (embedded->height == 0) ||
+            (!EmbeddedArtwork_decode(embedded, &pixels))) {
+            break;
+        }
+
+        image->create(embedded->width, embedded->height, &pixels[0]);
+        return true;
+    }
+#endif
+
+    // Not embedded, load it from the file
+    return image->loadFromFile(filename);
+}
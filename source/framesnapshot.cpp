@@ -0,0 +1,119 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "framesnapshot.h"
+
+///
+/// \brief The maximum no of changed regions. When it's reached, the whole 
+///        screen is redrawn instead.
+///
+#define FRAMESNAPSHOT_MAX_DIRTY_RECTS   16
+
+FrameSnapshot::FrameSnapshot() :
+    _isAllDirty(false)
+{
+}
+
+void FrameSnapshot::drawQuads(const sf::Vertex    *vertex, 
+                              unsigned int         vertexCount,
+                              const sf::Texture   *texture,
+                              const sf::Shader    *shader,
+                              const sf::Transform &transform) {
+    FrameSnapshotCommand command;
+    command.texture     = texture;
+    command.shader      = shader;
+    command.transform   = transform;
+    command.firstVertex = _vertex.size();
+    command.vertexCount = vertexCount;
+
+    // The vertex is only valid during the call, so it has to be copied
+    _vertex.insert(_vertex.end(), vertex, vertex + vertexCount);
+    _commands.push_back(command);
+}
+
+void FrameSnapshot::updateTexture(sf::Texture     *texture, 
+                                  const sf::Uint8 *pixels) {
+    sf::Vector2u size = texture->getSize();
+
+    FrameSnapshotTextureUpdate update;
+    update.texture    = texture;
+    update.firstPixel = _pixels.size();
+
+    _pixels.insert(_pixels.end(), pixels, pixels + (size.x * size.y * 4));
+    _textureUpdates.push_back(update);
+}
+
+void FrameSnapshot::draw(AbstractRenderBackend *backend) const {
+    for (unsigned int i = 0; i < _textureUpdates.size(); i++) {
+        backend->updateTexture(_textureUpdates[i].texture, 
+                               &_pixels[_textureUpdates[i].firstPixel]);
+    }
+
+    for (unsigned int i = 0; i < _commands.size(); i++) {
+        const FrameSnapshotCommand *command = &_commands[i];
+
+        backend->drawQuads(&_vertex[command->firstVertex], 
+                           command->vertexCount, 
+                           command->texture,
+                           command->shader,
+                           command->transform);
+    }
+}
+
+void FrameSnapshot::clear() {
+    _vertex.clear();
+    _commands.clear();
+    _textureUpdates.clear();
+    _pixels.clear();
+    _dirtyRects.clear();
+    _isAllDirty = false;
+}
+
+void FrameSnapshot::addDirtyRect(const sf::IntRect &rect) {
+    if (_isAllDirty) {
+        return;
+    }
+
+    if (_dirtyRects.size() >= FRAMESNAPSHOT_MAX_DIRTY_RECTS) {
+        invalidateAll();
+        return;
+    }
+
+    _dirtyRects.push_back(rect);
+}
+
+void FrameSnapshot::invalidateAll() {
+    _isAllDirty = true;
+    _dirtyRects.clear();
+}
+
+void FrameSnapshot::addDirtyRegion(const FrameSnapshot &snapshot) {
+    if (snapshot._isAllDirty) {
+        invalidateAll();
+        return;
+    }
+
+    for (unsigned int i = 0; i < snapshot._dirtyRects.size(); i++) {
+        addDirtyRect(snapshot._dirtyRects[i]);
+    }
+}
@@ -21,14 +21,65 @@
  * IN THE SOFTWARE.
  */
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <stack>
+#include <string>
+#include <vector>
 #include <SFML/Graphics.hpp>
 
+#include "assetloader.h"
+#include "dirtyregion.h"
+#include "framesnapshot.h"
 #include "gamemanager.h"
+#include "gamestatepool.h"
+#include "inputqueue.h"
+#include "jobsystem.h"
+#include "spritebatch.h"
+#include "targetrenderbackend.h"
+#include "textureatlas.h"
+#include "texturecache.h"
 
 #define GAMEWINDOW_WIDTH  480
 #define GAMEWINDOW_HEIGHT 320
 
+///
+/// \brief The default maximum frame rate
+///
+#define GAMEMANAGER_FRAMERATE_LIMIT     60
+
+///
+/// \brief The interval to check for new events while waiting for a pending
+///        update (SFML can't wait for an event with a timeout)
+///
+#define GAMEMANAGER_EVENT_POLL_INTERVAL sf::milliseconds(20)
+
+///
+/// \brief The simulation time step. The game states are always updated with
+///        this elapsed time, no matter how long a frame takes.
+///
+#define GAMEMANAGER_UPDATE_STEP         sf::milliseconds(10)
+
+///
+/// \brief The maximum no of update steps to catch up after a stalled frame. 
+///        The rest of the stalled time is dropped.
+///
+#define GAMEMANAGER_MAX_UPDATE_STEPS    10
+
+///
+/// \brief The flag in _readySnapshot to indicate that the ready snapshot 
+///        hasn't been drawn yet, and the mask for its index
+///
+#define GAMEMANAGER_SNAPSHOT_NEW        0x04
+#define GAMEMANAGER_SNAPSHOT_INDEX_MASK 0x03
+
+///
+/// \brief The time per frame for the completed jobs' callbacks
+///
+#define GAMEMANAGER_JOB_TIME_BUDGET     sf::milliseconds(2)
+
 ///
 /// \brief The handler for the game window
 ///
@@ -60,15 +111,205 @@ static AbstractGameState *_currentGameState;
 ///
 static bool _disposeCurrentGameState;
 
+///
+/// \brief Collect the quads drawn by the game state during a frame
+///
+static SpriteBatch _spriteBatch;
+
+///
+/// \brief The persistent back buffer for the partial redraw mode. It keeps
+///        the last frame, so only the changed regions need to be redrawn.
+///
+static sf::RenderTexture _backBuffer;
+
+///
+/// \brief Flag to indicate that the back buffer has been created
+///
+static bool _hasBackBuffer;
+
+///
+/// \brief Flag to indicate that only the changed regions are redrawn
+///
+static bool _usePartialRedraw;
+
+///
+/// \brief The changed regions of the frame that's being recorded. Kept 
+///        across frames, so they don't need to be allocated every frame.
+///
+static std::vector<sf::IntRect> _dirtyRects;
+
+///
+/// \brief The last frame of the game state that's covered by an overlay 
+///        (see AbstractGameState::isOverlay())
+///
+static sf::RenderTexture _frozenFrame;
+
+///
+/// \brief Flag to indicate that the frozen frame's render texture has been 
+///        created
+///
+static bool _hasFrozenFrameBuffer;
+
+///
+/// \brief Flag to indicate that the frozen frame holds the covered game 
+///        state's frame
+///
+static bool _isFrameFrozen;
+
+///
+/// \brief The frame snapshots, triple buffered: one is written by the game
+///        loop, one is ready to be drawn, and one is drawn by the render 
+///        thread. The snapshots only change owner by swapping the indices.
+///
+static FrameSnapshot _frameSnapshots[3];
+
+///
+/// \brief The snapshot that's written by the game loop. Only used by the 
+///        game loop.
+///
+static unsigned int _writeSnapshot = 0;
+
+///
+/// \brief The newest complete snapshot, with GAMEMANAGER_SNAPSHOT_NEW if it
+///        hasn't been drawn yet. It's swapped atomically with the write or 
+///        the draw snapshot, so publishing a frame never waits for the 
+///        render thread.
+///
+static std::atomic<unsigned int> _readySnapshot(1);
+
+///
+/// \brief The snapshot that's drawn by the render thread. Only used by the
+///        render thread.
+///
+static unsigned int _drawSnapshot  = 2;
+
+///
+/// \brief Flag to keep the render thread running
+///
+static bool _renderThreadIsRunning;
+
+///
+/// \brief The vertical sync setting. It's applied by the render thread, 
+///        which owns the window's OpenGL context.
+///
+static bool _useVerticalSync;
+
+///
+/// \brief Protect the render thread's flags. The render thread sleeps on 
+///        _renderThreadSignal with it, until there's a new snapshot.
+///
+static std::mutex _renderThreadMutex;
+
+///
+/// \brief Wake up the render thread for a new snapshot, or for a change of 
+///        its flags
+///
+static std::condition_variable _renderThreadSignal;
+
+///
+/// \brief Locked by the render thread while it's taking and drawing a 
+///        snapshot, so the game loop can wait until the drawing has 
+///        finished
+///
+static sf::Mutex _renderMutex;
+
+///
+/// \brief The frame pacing policy of the game loop
+///
+static enum _framePacing _pacingPolicy;
+
+///
+/// \brief The minimum time between 2 frames, or zero for no frame rate limit
+///
+static sf::Time _minimumFrameTime;
+
+///
+/// \brief The elapsed time that hasn't been simulated yet (less than a single
+///        update step, unless the game state has changed during the update)
+///
+static sf::Time _updateAccumulator;
+
+///
+/// \brief The time between polling the last processed key from the system 
+///        and sending it to the game state
+///
+static sf::Time _queueLatency;
+
+///
+/// \brief The artwork to be packed into the texture atlas. The splash screen
+///        is shown while the atlas is loading, so it's not in the atlas.
+///
+static const char *_gameArtwork[] = {
+    "artwork/sudoku-menu-background.png",
+    "artwork/sudoku-game-background.png",
+    "artwork/sudoku-gameover-background.png",
+    "artwork/sudoku-menu.png",
+    "artwork/sudoku-submenu.png",
+    "artwork/sudoku-pausemenu.png",
+    "artwork/sudoku-numbertiles-24px.png",
+    "artwork/sudoku-numbertiles-black-24px.png",
+    "artwork/sudoku-pencilmarks-8px.png",
+    "artwork/sudoku-cursor-36px.png"
+};
+
 //-----------------------------------------------------------------------------
-static void GameManager_processEvents() {
+///
+/// \brief Get the first event from the system, waiting for it if necessary
+///
+/// \param gameEvent The event to be filled
+/// \param timeout   The maximum time to wait. Zero to return immediately, 
+///                  and negative to wait until there's an event.
+///
+/// \return true if there's an event
+///
+static bool GameManager_waitEvent(sf::Event *gameEvent, sf::Time timeout) {
+    if (timeout < sf::Time::Zero) {
+        // Nothing is going to change until there's an event. Sleep in the
+        // system until it arrives.
+        return _gameWindow.waitEvent(*gameEvent);
+    }
+
+    sf::Clock waitClock;
+
+    while (!_gameWindow.pollEvent(*gameEvent)) {
+        sf::Time waitTime = waitClock.getElapsedTime();
+
+        if (waitTime >= timeout) {
+            return false;
+        }
+
+        sf::sleep(std::min(timeout - waitTime, 
+                           GAMEMANAGER_EVENT_POLL_INTERVAL));
+    }
+
+    return true;
+}
+
+///
+/// \brief Get the events from the system, and queue them for the game state
+///
+/// \param timeout The maximum time to wait for the first event. Zero to 
+///                only process the pending events, and negative to wait
+///                until there's an event.
+///
+/// \return The time spent waiting for the first event
+///
+static sf::Time GameManager_processEvents(sf::Time timeout) {
     sf::Event gameEvent;
+    sf::Clock waitClock;
+    bool      hasEvent = GameManager_waitEvent(&gameEvent, timeout);
+    sf::Time  waitTime = waitClock.getElapsedTime();
     
     // Check if we have some event coming
-    while (_gameWindow.pollEvent(gameEvent)) {
+    for (; hasEvent; hasEvent = _gameWindow.pollEvent(gameEvent)) {
         // Update the state for the event. Some of the event is handled 
-        // directly by the GameManager, the rest is handled by the Game
+        // directly by the GameManager, the rest is queued for the Game
         // State
+        // SFML doesn't tell when the event was received, so it's stamped 
+        // with the time it's polled
+        sf::Time timestamp = InputQueue_now();
+        enum AbstractController::_keys key;
+
         switch (gameEvent.type) {
         case sf::Event::Closed: {
             // Stop the game
@@ -79,105 +320,15 @@ static void GameManager_processEvents() {
         case sf::Event::LostFocus: 
         case sf::Event::GainedFocus: {
             // Send pause event to the game state
-            _currentGameState->
-                processKeypressEvent(AbstractController::KEY_PAUSE);
+            InputQueue_push(AbstractController::KEY_PAUSE, timestamp);
             break;
         }
 
         case sf::Event::KeyPressed: {
-            switch (gameEvent.key.code) {
-            case sf::Keyboard::Escape: {
-                // Toggle pause event to the game state
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_PAUSE);
-                break;
-            }
-            case sf::Keyboard::Up: {
-                // Send key up event to the game state
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_UP);
-                break;
-            }
-            case sf::Keyboard::Down: {
-                // Send key down event to the game state
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_DOWN);
-                break;
-            }
-            case sf::Keyboard::Left: {
-                // Send key left event to the game state
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_LEFT);
-                break;
-            }
-            case sf::Keyboard::Right: {
-                // Send key right event to the game state
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_RIGHT);
-                break;
-            }
-            case sf::Keyboard::Space: 
-            case sf::Keyboard::Return: {
-                // Send key select event to the game state
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_SELECT);
-                break;
-            }
-            case sf::Keyboard::Num1: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_1);
-                break;
-            }
-            case sf::Keyboard::Num2: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_2);
-                break;
-            }
-            case sf::Keyboard::Num3: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_3);
-                break;
-            }
-            case sf::Keyboard::Num4: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_4);
-                break;
-            }
-            case sf::Keyboard::Num5: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_5);
-                break;
-            }
-            case sf::Keyboard::Num6: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_6);
-                break;
-            }
-            case sf::Keyboard::Num7: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_7);
-                break;
-            }
-            case sf::Keyboard::Num8: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_8);
-                break;
-            }
-            case sf::Keyboard::Num9: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_9);
-                break;
-            }
-            case sf::Keyboard::Delete: {
-                _currentGameState->
-                    processKeypressEvent(AbstractController::KEY_DELETE);
-                break;
-            }
-            default: {
-                // Other keyboard input. Ignore it.
-                break;
-            }
+            if (InputQueue_mapKey(gameEvent.key, &key)) {
+                InputQueue_push(key, timestamp);
             }
+            break;
         }
 
         case sf::Event::MouseMoved: {
@@ -196,8 +347,332 @@ static void GameManager_processEvents() {
         }
         }
     }
+
+    return waitTime;
+}
+
+///
+/// \brief Continue loading the artwork in the background
+///
+static void GameManager_loadAssets() {
+    if ((AssetLoader_isFinished()) || (!AssetLoader_update())) {
+        return;
+    }
+
+    // Keep the textures that are used by most of the game states, so they're
+    // not reloaded on every game state transition
+    TextureCache_pin("artwork/sudoku-menu-background.png");
+    TextureCache_pin("artwork/sudoku-numbertiles-24px.png");
+    TextureCache_pin("artwork/sudoku-cursor-36px.png");
+}
+
+///
+/// \brief Check whether the current game state is still on the top of the 
+///        stack. If not, it has been replaced or covered, and it's suspended.
+///
+static bool GameManager_isCurrentStateOnTop() {
+    return ((!_gameStateStack.empty()) && 
+            (_gameStateStack.top() == _currentGameState));
+}
+
+///
+/// \brief Advance the current game state in fixed time steps, until only 
+///        the given time is left to be simulated
+///
+/// \param remainingTime The time to be left in the accumulator
+///
+static void GameManager_stepGameState(sf::Time remainingTime) {
+    while (_updateAccumulator - remainingTime >= GAMEMANAGER_UPDATE_STEP) {
+        if (!GameManager_isCurrentStateOnTop()) {
+            // The rest of the time is for the next game state
+            break;
+        }
+
+        _currentGameState->update(GAMEMANAGER_UPDATE_STEP);
+        _updateAccumulator -= GAMEMANAGER_UPDATE_STEP;
+    }
+}
+
+///
+/// \brief Advance the current game state in fixed time steps, and send it 
+///        the queued keys in between the steps
+///
+/// \param elapsedTime The real time that has elapsed since the last call
+/// \param maxCatchUp  The maximum time to be simulated in this call
+/// \param inputTime   The time of the input clock that's reached by the 
+///                    elapsed time
+///
+static void GameManager_updateGameState(sf::Time elapsedTime, 
+                                        sf::Time maxCatchUp,
+                                        sf::Time inputTime) {
+    InputEvent inputEvent;
+
+    _updateAccumulator += elapsedTime;
+    _updateAccumulator  = std::min(_updateAccumulator, maxCatchUp);
+
+    while ((GameManager_isCurrentStateOnTop()) && 
+           (InputQueue_peek(&inputEvent))) {
+        // Simulate the time up to the key first, so the key sees the game 
+        // state as it was when the key was received (e.g. the score that 
+        // has been counted down while waiting for the key). The keys from
+        // the time that isn't simulated are sent right away.
+        GameManager_stepGameState(
+            std::max(inputTime - inputEvent.timestamp, sf::Time::Zero)
+        );
+
+        if (!GameManager_isCurrentStateOnTop()) {
+            // The game state has been replaced. The rest of the keys are for
+            // the next game state.
+            break;
+        }
+
+        InputQueue_pop(&inputEvent);
+        _currentGameState->processInputEvent(inputEvent.key, 
+                                             inputEvent.timestamp);
+        _queueLatency = InputQueue_now() - inputEvent.timestamp;
+    }
+
+    // Simulate the rest of the time after the last key
+    GameManager_stepGameState(sf::Time::Zero);
+
+    // Let the views draw the state in between the last and the next step
+    float alpha = 
+        _updateAccumulator.asSeconds() / GAMEMANAGER_UPDATE_STEP.asSeconds();
+    _currentGameState->interpolate(std::min(alpha, 1.f));
+}
+
+///
+/// \brief Draw the game state's frame into the frozen frame, so an overlay 
+///        can be drawn over it without drawing the game state every frame
+///
+/// \param state The game state that's going to be covered
+///
+static void GameManager_freezeFrame(AbstractGameState *state) {
+    _isFrameFrozen = false;
+
+    if (!_hasFrozenFrameBuffer) {
+        return;
+    }
+
+    SpriteBatch batch;
+    state->draw(&batch);
+
+    // The render thread may still be drawing a frame that uses the last 
+    // frozen frame
+    sf::Lock lock(_renderMutex);
+
+    _frozenFrame.clear();
+    batch.flush(&_frozenFrame);
+    _frozenFrame.display();
+
+    _isFrameFrozen = true;
+}
+
+///
+/// \brief Record the current game state's frame into the write snapshot, 
+///        then publish it to the render thread
+///
+static void GameManager_publishFrame() {
+    FrameSnapshot *snapshot = &_frameSnapshots[_writeSnapshot];
+    snapshot->clear();
+
+    bool isAllDirty = DirtyRegion_take(&_dirtyRects);
+
+    if ((!_usePartialRedraw) || (isAllDirty)) {
+        snapshot->invalidateAll();
+    } else {
+        if (_dirtyRects.empty()) {
+            // Nothing has changed, the window still shows the last frame
+            return;
+        }
+
+        for (unsigned int i = 0; i < _dirtyRects.size(); i++) {
+            snapshot->addDirtyRect(_dirtyRects[i]);
+        }
+    }
+
+    // Ask state to redraw, then record everything it has submitted
+    _currentGameState->draw(&_spriteBatch);
+    _spriteBatch.flush(snapshot);
+
+    // Swap the write and the ready snapshot. It only fails if the render 
+    // thread has taken the ready snapshot in the meantime.
+    unsigned int readySnapshot = 
+        _readySnapshot.load(std::memory_order_acquire);
+
+    do {
+        if (readySnapshot & GAMEMANAGER_SNAPSHOT_NEW) {
+            // The render thread hasn't drawn the previous frame. Its changed
+            // regions have to be redrawn with this frame.
+            unsigned int index = 
+                readySnapshot & GAMEMANAGER_SNAPSHOT_INDEX_MASK;
+            snapshot->addDirtyRegion(_frameSnapshots[index]);
+        }
+    } while (!_readySnapshot.compare_exchange_strong(
+                 readySnapshot, 
+                 _writeSnapshot | GAMEMANAGER_SNAPSHOT_NEW,
+                 std::memory_order_acq_rel,
+                 std::memory_order_acquire));
+
+    _writeSnapshot = readySnapshot & GAMEMANAGER_SNAPSHOT_INDEX_MASK;
+
+    // Wake up the render thread. The mutex is locked, so the signal isn't 
+    // lost while the render thread is about to sleep.
+    {
+        std::lock_guard<std::mutex> lock(_renderThreadMutex);
+    }
+    _renderThreadSignal.notify_one();
+}
+
+///
+/// \brief Redraw the changed regions of the snapshot into the back buffer, 
+///        then copy the back buffer to the window
+///
+/// \param snapshot The frame to be drawn
+///
+static void GameManager_drawDirtyRegions(const FrameSnapshot *snapshot) {
+    sf::IntRect screenRect(0, 0, GAMEWINDOW_WIDTH, GAMEWINDOW_HEIGHT);
+    std::vector<sf::IntRect> dirtyRects;
+
+    if (snapshot->isAllDirty()) {
+        dirtyRects.push_back(screenRect);
+    } else {
+        dirtyRects = snapshot->dirtyRects();
+    }
+
+    TargetRenderBackend backend(&_backBuffer);
+    bool hasRedrawn = false;
+
+    for (unsigned int i = 0; i < dirtyRects.size(); i++) {
+        sf::IntRect dirtyRect;
+        if (!screenRect.intersects(dirtyRects[i], dirtyRect)) {
+            // The region is outside the screen
+            continue;
+        }
+
+        sf::FloatRect region(dirtyRect);
+
+        // Only the region is drawn, everything outside it is clipped
+        sf::View regionView(region);
+        regionView.setViewport(
+            sf::FloatRect(region.left   / GAMEWINDOW_WIDTH,
+                          region.top    / GAMEWINDOW_HEIGHT,
+                          region.width  / GAMEWINDOW_WIDTH,
+                          region.height / GAMEWINDOW_HEIGHT)
+        );
+        _backBuffer.setView(regionView);
+
+        // Clear the region below everything else
+        float right  = region.left + region.width;
+        float bottom = region.top  + region.height;
+        sf::Vertex clearQuad[4] = {
+            sf::Vertex(sf::Vector2f(region.left,    region.top), 
+                       sf::Color::Black),
+            sf::Vertex(sf::Vector2f(      right,    region.top), 
+                       sf::Color::Black),
+            sf::Vertex(sf::Vector2f(      right,        bottom), 
+                       sf::Color::Black),
+            sf::Vertex(sf::Vector2f(region.left,        bottom), 
+                       sf::Color::Black)
+        };
+        backend.drawQuads(clearQuad, 4, NULL, NULL, sf::Transform::Identity);
+
+        snapshot->draw(&backend);
+
+        hasRedrawn = true;
+    }
+
+    if (hasRedrawn) {
+        _backBuffer.display();
+    }
+
+    // Copy the whole back buffer into the window
+    _gameWindow.draw(sf::Sprite(_backBuffer.getTexture()));
+}
+
+///
+/// \brief The render thread. Draw the newest frame snapshot into the window,
+///        so a slow present never delays the game loop.
+///
+static void GameManager_renderLoop() {
+    _gameWindow.setActive(true);
+
+    bool useVerticalSync;
+    {
+        std::lock_guard<std::mutex> lock(_renderThreadMutex);
+        useVerticalSync = _useVerticalSync;
+    }
+    _gameWindow.setVerticalSyncEnabled(useVerticalSync);
+
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(_renderThreadMutex);
+
+            // Sleep until there's something to do
+            while ((_renderThreadIsRunning) && 
+                   (useVerticalSync == _useVerticalSync) &&
+                   ((_readySnapshot.load(std::memory_order_acquire) & 
+                     GAMEMANAGER_SNAPSHOT_NEW) == 0)) {
+                _renderThreadSignal.wait(lock);
+            }
+
+            if (!_renderThreadIsRunning) {
+                break;
+            }
+
+            if (useVerticalSync != _useVerticalSync) {
+                useVerticalSync = _useVerticalSync;
+                _gameWindow.setVerticalSyncEnabled(useVerticalSync);
+            }
+        }
+
+        // Take the newest snapshot, the older ones are skipped. It's taken 
+        // with the render mutex locked, so the game loop can't drop it and 
+        // delete its resources before it's drawn.
+        sf::Lock lock(_renderMutex);
+        unsigned int readySnapshot = 
+            _readySnapshot.load(std::memory_order_acquire);
+
+        while ((readySnapshot & GAMEMANAGER_SNAPSHOT_NEW) &&
+               (!_readySnapshot.compare_exchange_weak(
+                    readySnapshot, 
+                    _drawSnapshot,
+                    std::memory_order_acq_rel,
+                    std::memory_order_acquire))) {
+            // The game loop has published a newer snapshot, take that one
+        }
+
+        if ((readySnapshot & GAMEMANAGER_SNAPSHOT_NEW) == 0) {
+            // The snapshot has been dropped by the game loop
+            continue;
+        }
+
+        _drawSnapshot = readySnapshot & GAMEMANAGER_SNAPSHOT_INDEX_MASK;
+        const FrameSnapshot *snapshot = &_frameSnapshots[_drawSnapshot];
+
+        if (_hasBackBuffer) {
+            // Only redraw the regions that have changed. Without the partial
+            // redraw, the snapshot marks the whole screen as changed.
+            GameManager_drawDirtyRegions(snapshot);
+        } else {
+            TargetRenderBackend backend(&_gameWindow);
+
+            _gameWindow.clear();
+            snapshot->draw(&backend);
+        }
+
+        // Re-paint the window
+        _gameWindow.display();
+    }
+
+    _gameWindow.setActive(false);
 }
 
+///
+/// \brief The thread that runs GameManager_renderLoop()
+///
+static sf::Thread _renderThread(&GameManager_renderLoop);
+
 //-----------------------------------------------------------------------------
 void GameManager_init(void) {
     _gameWindow.create(sf::VideoMode(GAMEWINDOW_WIDTH, GAMEWINDOW_HEIGHT),
@@ -207,21 +682,76 @@ void GameManager_init(void) {
     _gameIsRunning = true;
     _disposeCurrentGameState = false;
 
+    // Don't draw more frames than the monitor can show, and sleep while 
+    // there's nothing to update
+    GameManager_setFramePacing(FRAMEPACING_EVENT_DRIVEN);
+    GameManager_setFrameRateLimit(GAMEMANAGER_FRAMERATE_LIMIT);
+    GameManager_setVerticalSync(true);
+
     // Center the game window in the center of the screen
     sf::VideoMode desktop = sf::VideoMode::getDesktopMode();
 
     sf::Vector2i  screenCenterPos((desktop.width  - GAMEWINDOW_WIDTH ) / 2,
                                   (desktop.height - GAMEWINDOW_HEIGHT) / 2);
     _gameWindow.setPosition(screenCenterPos);
+
+    // Start the workers for the background jobs
+    JobSystem_init();
+
+    // Decode all of the artwork in the background, while the splash screen 
+    // is shown. It's packed into a single texture. If it fails, each image
+    // is loaded into its own texture.
+    std::vector<std::string> artwork;
+    for (unsigned int i = 0; 
+         i < sizeof(_gameArtwork) / sizeof(_gameArtwork[0]); i++) {
+        artwork.push_back(_gameArtwork[i]);
+    }
+
+    AssetLoader_start(artwork);
+
+    // Use the partial redraw mode if the back buffer can be created
+    _hasBackBuffer = 
+        _backBuffer.create(GAMEWINDOW_WIDTH, GAMEWINDOW_HEIGHT);
+
+    // The back buffer is only drawn by the render thread
+    _backBuffer.setActive(false);
+    _usePartialRedraw = _hasBackBuffer;
+
+    // The overlays are drawn over the covered game state's frozen frame, if
+    // it can be created. Otherwise they draw their own background.
+    _hasFrozenFrameBuffer = 
+        _frozenFrame.create(GAMEWINDOW_WIDTH, GAMEWINDOW_HEIGHT);
+    _isFrameFrozen = false;
+    DirtyRegion_invalidateAll();
 }
 
 void GameManager_pushGameState(AbstractGameState *state) {
+    // The game state may have been constructed in a worker thread
+    state->loadGraphics();
+
+    if ((state->isOverlay()) && (!_gameStateStack.empty()) &&
+        (!_gameStateStack.top()->isOverlay())) {
+        // Keep the covered game state's last frame, the overlay is drawn 
+        // over it
+        GameManager_freezeFrame(_gameStateStack.top());
+    }
+
     _gameStateStack.push(state);
+
+    // A new game state has to be drawn from scratch
+    DirtyRegion_invalidateAll();
 }
 
 void GameManager_popGameState() {
+    if (_gameStateStack.top()->isOverlay()) {
+        _isFrameFrozen = false;
+    }
+
     _deletedGameState.push(_gameStateStack.top());
     _gameStateStack.pop();
+
+    // Redraw the game state that's below the removed one
+    DirtyRegion_invalidateAll();
     
     _disposeCurrentGameState = true;
 }
@@ -230,38 +760,151 @@ void GameManager_stop() {
     _gameIsRunning = false;
 }
 
+void GameManager_setPartialRedraw(bool enable) {
+    _usePartialRedraw = (enable && _hasBackBuffer);
+    DirtyRegion_invalidateAll();
+}
+
+void GameManager_setFramePacing(enum _framePacing pacing) {
+    _pacingPolicy = pacing;
+}
+
+void GameManager_setFrameRateLimit(unsigned int frameRate) {
+    if (frameRate > 0) {
+        _minimumFrameTime = sf::seconds(1.f / frameRate);
+    } else {
+        _minimumFrameTime = sf::Time::Zero;
+    }
+}
+
+void GameManager_setVerticalSync(bool enable) {
+    {
+        std::lock_guard<std::mutex> lock(_renderThreadMutex);
+        _useVerticalSync = enable;
+    }
+    _renderThreadSignal.notify_one();
+}
+
+const sf::Texture *GameManager_frozenFrame() {
+    if (!_isFrameFrozen) {
+        return NULL;
+    }
+
+    return &_frozenFrame.getTexture();
+}
+
+sf::Time GameManager_queueLatency() {
+    return _queueLatency;
+}
+
+const SpriteBatchStats &GameManager_renderStats() {
+    return _spriteBatch.stats();
+}
+
 void GameManager_run() {
     sf::Clock gameClock;
+    sf::Clock frameClock;
+
+    // Hand the window's OpenGL context over to the render thread
+    _gameWindow.setActive(false);
+    _renderThreadIsRunning = true;
+    _renderThread.launch();
+
+    // The time to wait for an event before the next frame is drawn. Negative
+    // to wait until there's an event.
+    sf::Time  eventTimeout = sf::Time::Zero;
 
     while (_gameIsRunning) {
         // Sync the current game state
         _currentGameState = _gameStateStack.top();
 
-        // Get the events from the system, and send it to the game state
-        GameManager_processEvents();
+        // Get the events from the system, and send it to the game state. 
+        // Wait for them if the game state has nothing to update.
+        sf::Time waitTime    = GameManager_processEvents(eventTimeout);
+        sf::Time elapsedTime = gameClock.restart();
+        sf::Time inputTime   = InputQueue_now();
+        sf::Time maxCatchUp  = GAMEMANAGER_UPDATE_STEP * 
+                               (sf::Int64) GAMEMANAGER_MAX_UPDATE_STEPS;
 
-        // Update the current game state view with elapsed time
-        _currentGameState->update(gameClock.restart());
+        waitTime = std::min(waitTime, elapsedTime);
 
-        // Clear the current window
-        _gameWindow.clear();
+        if (eventTimeout < sf::Time::Zero) {
+            // The game state doesn't depend on the time it has waited for 
+            // an input
+            elapsedTime -= waitTime;
+        } else {
+            // The game state has asked to sleep until its next update. It's
+            // not a stalled frame, so all of the time has to be simulated.
+            maxCatchUp  += waitTime;
+        }
 
-        // Ask state to redraw
-        _currentGameState->draw(&_gameWindow);
+        // Send the finished jobs' results to the game state, then update the
+        // current game state in fixed time steps, with the keys sent in 
+        // between the steps at the time they were received
+        JobSystem_processCompleted(GAMEMANAGER_JOB_TIME_BUDGET);
+        GameManager_loadAssets();
+        GameManager_updateGameState(elapsedTime, maxCatchUp, inputTime);
 
-        // Re-paint the window
-        _gameWindow.display();
+        // Hand the frame over to the render thread
+        GameManager_publishFrame();
 
         if (_disposeCurrentGameState) {
+            // The last frame still uses the removed game states' resources.
+            // Drop it, and wait until the render thread isn't drawing. The
+            // next frame redraws the whole screen anyway.
+            _readySnapshot.fetch_and(~GAMEMANAGER_SNAPSHOT_NEW, 
+                                     std::memory_order_acq_rel);
+
+            DirtyRegion_invalidateAll();
+            sf::Lock lock(_renderMutex);
+
             while (!_deletedGameState.empty()) {
+                // Keep it to be reused, if it can be
                 AbstractGameState *gameState = _deletedGameState.top();
-                delete gameState;
+                GameStatePool_release(gameState);
                 _deletedGameState.pop();
             }
             
             _disposeCurrentGameState = false;
         }
+
+        // Keep the frame rate below the limit
+        sf::Time frameTime = frameClock.getElapsedTime();
+        if (frameTime < _minimumFrameTime) {
+            sf::sleep(_minimumFrameTime - frameTime);
+        }
+        frameClock.restart();
+
+        // Decide how long the next frame can wait for an event. A new game 
+        // state is always drawn immediately.
+        eventTimeout = sf::Time::Zero;
+
+        if ((_pacingPolicy == FRAMEPACING_EVENT_DRIVEN) && 
+            (!_gameStateStack.empty()) &&
+            (_gameStateStack.top() == _currentGameState)) {
+            eventTimeout = _currentGameState->timeToNextUpdate();
+        }
+
+        if (JobSystem_hasPendingJobs() &&
+            ((eventTimeout < sf::Time::Zero) || 
+             (eventTimeout > GAMEMANAGER_EVENT_POLL_INTERVAL))) {
+            // Wake up regularly to complete the background jobs
+            eventTimeout = GAMEMANAGER_EVENT_POLL_INTERVAL;
+        }
+    }
+
+    // Stop the render thread before the game states are removed
+    {
+        std::lock_guard<std::mutex> lock(_renderThreadMutex);
+        _renderThreadIsRunning = false;
     }
+    _renderThreadSignal.notify_one();
+
+    _renderThread.wait();
+    _gameWindow.setActive(true);
+
+    // Stop the background jobs, they may still use the game states' data
+    JobSystem_shutdown();
 
     // Clean up all the game state that's still left on the stack
     while(!_gameStateStack.empty()) {
@@ -270,4 +913,10 @@ void GameManager_run() {
         delete gameState;
         _gameStateStack.pop();
     }
+
+    GameStatePool_clear();
+
+    // Release the textures while the window is still open
+    TextureCache_unpinAll();
+    TextureAtlas_destroy();
 }
@@ -53,7 +53,8 @@
 
 //-----------------------------------------------------------------------------
 GameOverState::GameOverState(unsigned int lastScore) {
-    _backgroundTexture.loadFromFile("artwork/sudoku-gameover-background.png");
+    _backgroundTexture = 
+        SharedTexture("artwork/sudoku-gameover-background.png");
 
     // Init the score widget
     _scoreDigitModel = std::vector<unsigned int> (SCORE_DIGIT_LENGTH, 0);
@@ -79,6 +80,7 @@ GameOverState::GameOverState(unsigned int lastScore) {
 
     // Set the last score into the widget
     SudokuScore::scoreToDigit(&_scoreDigitModel, lastScore);
+    _scoreDigitModelAdapter.markChanged();
 }
 
 GameOverState::~GameOverState() {
@@ -96,9 +98,10 @@ void GameOverState::update(sf::Time elapsedTime) {
     _scoreDigitView.update(elapsedTime);
 }
 
-void GameOverState::draw(sf::RenderWindow *win) {
-    sf::Sprite background(_backgroundTexture);
-    win->draw(background);
+void GameOverState::draw(SpriteBatch *batch) {
+    sf::Sprite background(*_backgroundTexture.get(), 
+                          _backgroundTexture.getRegion());
+    batch->draw(background, SPRITE_LAYER_BACKGROUND);
 
-    _scoreDigitView.draw(win);
+    _scoreDigitView.draw(batch);
 }
@@ -0,0 +1,128 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "gamestatebuilder.h"
+#include "gamestatepool.h"
+
+//-----------------------------------------------------------------------------
+///
+/// \brief Construct the game state in a worker thread
+///
+class GameStateBuildJob : public AbstractJob {
+public:
+    GameStateBuildJob(GameStateBuilder *builder, GameStateFactory factory) :
+        _builder(builder),
+        _factory(factory),
+        _gameState(NULL)
+    {
+    }
+
+    virtual ~GameStateBuildJob() {
+        // Cancelled, nobody is going to use it
+        GameStatePool_release(_gameState);
+    }
+
+    virtual void run() {
+        _gameState = _factory();
+    }
+
+    virtual void complete() {
+        _builder->setGameState(_gameState);
+        _gameState = NULL;
+    }
+
+private:
+    GameStateBuilder  *_builder;
+    GameStateFactory   _factory;
+    AbstractGameState *_gameState;
+};
+
+//-----------------------------------------------------------------------------
+GameStateBuilder::GameStateBuilder() :
+    _factory(NULL),
+    _jobId(0),
+    _isBuilding(false),
+    _gameState(NULL)
+{
+}
+
+GameStateBuilder::~GameStateBuilder() {
+    reset();
+}
+
+void GameStateBuilder::start(GameStateFactory                factory, 
+                             const std::vector<std::string> &textures) {
+    reset();
+
+    if (factory == NULL) {
+        return;
+    }
+
+    _factory = factory;
+
+    // Load the textures in this thread, the worker can't upload them to the
+    // graphic card
+    for (unsigned int i = 0; i < textures.size(); i++) {
+        _textures.push_back(SharedTexture(textures[i]));
+    }
+
+    // It's only speculative, the other jobs go first
+    _jobId      = JobSystem_submit(new GameStateBuildJob(this, factory),
+                                   JOB_PRIORITY_LOW);
+    _isBuilding = true;
+}
+
+AbstractGameState *GameStateBuilder::take() {
+    AbstractGameState *state = _gameState;
+    _gameState = NULL;
+
+    if ((state == NULL) && (_factory != NULL)) {
+        // Not built yet, don't wait for it
+        state = _factory();
+    }
+
+    reset();
+
+    return state;
+}
+
+void GameStateBuilder::setGameState(AbstractGameState *state) {
+    GameStatePool_release(_gameState);
+
+    _gameState  = state;
+    _isBuilding = false;
+}
+
+//-----------------------------------------------------------------------------
+void GameStateBuilder::reset() {
+    if (_isBuilding) {
+        JobSystem_cancel(_jobId);
+        _isBuilding = false;
+    }
+
+    GameStatePool_release(_gameState);
+    _gameState = NULL;
+
+    _factory = NULL;
+    _textures.clear();
+}
@@ -0,0 +1,107 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <map>
+#include <vector>
+#include <SFML/System.hpp>
+#include "gamestatepool.h"
+
+///
+/// \brief The max no of game states that are kept in each pool. Only one 
+///        game is played at a time, so a single spare is enough.
+///
+#define GAMESTATEPOOL_MAX_STATES    1
+
+///
+/// \brief The unused game states, indexed by their pool name
+///
+static std::map<std::string, std::vector<AbstractGameState *> > _pools;
+
+///
+/// \brief Protect the pools. The game states can be acquired by a worker 
+///        thread (see gamestatebuilder.h).
+///
+static sf::Mutex _poolMutex;
+
+//-----------------------------------------------------------------------------
+void GameStatePool_release(AbstractGameState *state) {
+    if (state == NULL) {
+        return;
+    }
+
+    if (state->poolName() != NULL) {
+        sf::Lock lock(_poolMutex);
+
+        std::vector<AbstractGameState *> &pool = _pools[state->poolName()];
+        if (pool.size() < GAMESTATEPOOL_MAX_STATES) {
+            pool.push_back(state);
+            return;
+        }
+    }
+
+    delete state;
+}
+
+AbstractGameState *GameStatePool_acquire(const std::string &poolName) {
+    sf::Lock lock(_poolMutex);
+
+    std::map<std::string, std::vector<AbstractGameState *> >::iterator it =
+        _pools.find(poolName);
+
+    if ((it == _pools.end()) || (it->second.empty())) {
+        return NULL;
+    }
+
+    AbstractGameState *state = it->second.back();
+    it->second.pop_back();
+
+    return state;
+}
+
+void GameStatePool_clear() {
+    // Deleting a game state may release another game state into the pools 
+    // (e.g. the submenu's built play state), so repeat until they're empty
+    while (true) {
+        std::vector<AbstractGameState *> states;
+
+        {
+            sf::Lock lock(_poolMutex);
+
+            std::map<std::string, 
+                     std::vector<AbstractGameState *> >::iterator it;
+            for (it = _pools.begin(); it != _pools.end(); ++it) {
+                states.insert(states.end(), 
+                              it->second.begin(), it->second.end());
+            }
+            _pools.clear();
+        }
+
+        if (states.empty()) {
+            return;
+        }
+
+        for (unsigned int i = 0; i < states.size(); i++) {
+            delete states[i];
+        }
+    }
+}
@@ -0,0 +1,195 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <atomic>
+#include "inputqueue.h"
+
+///
+/// \brief The no of events in the ring. Must be a power of 2.
+///
+#define INPUTQUEUE_SIZE     64
+
+///
+/// \brief The game key for each of the system's keys: the key without and 
+///        with the shift key
+///
+struct InputQueueKeyMap {
+    sf::Keyboard::Key              code;
+    enum AbstractController::_keys key;
+    enum AbstractController::_keys shiftKey;
+};
+
+static const InputQueueKeyMap _keyMap[] = {
+    { sf::Keyboard::Escape, AbstractController::KEY_PAUSE,  
+                            AbstractController::KEY_PAUSE       },
+    { sf::Keyboard::Up,     AbstractController::KEY_UP,     
+                            AbstractController::KEY_UP          },
+    { sf::Keyboard::Down,   AbstractController::KEY_DOWN,   
+                            AbstractController::KEY_DOWN        },
+    { sf::Keyboard::Left,   AbstractController::KEY_LEFT,   
+                            AbstractController::KEY_LEFT        },
+    { sf::Keyboard::Right,  AbstractController::KEY_RIGHT,  
+                            AbstractController::KEY_RIGHT       },
+    { sf::Keyboard::Space,  AbstractController::KEY_SELECT, 
+                            AbstractController::KEY_SELECT      },
+    { sf::Keyboard::Return, AbstractController::KEY_SELECT, 
+                            AbstractController::KEY_SELECT      },
+    // Shift + digit seeks the next tile that accepts the digit
+    { sf::Keyboard::Num1,   AbstractController::KEY_1,      
+                            AbstractController::KEY_SEEK_1      },
+    { sf::Keyboard::Num2,   AbstractController::KEY_2,      
+                            AbstractController::KEY_SEEK_2      },
+    { sf::Keyboard::Num3,   AbstractController::KEY_3,      
+                            AbstractController::KEY_SEEK_3      },
+    { sf::Keyboard::Num4,   AbstractController::KEY_4,      
+                            AbstractController::KEY_SEEK_4      },
+    { sf::Keyboard::Num5,   AbstractController::KEY_5,      
+                            AbstractController::KEY_SEEK_5      },
+    { sf::Keyboard::Num6,   AbstractController::KEY_6,      
+                            AbstractController::KEY_SEEK_6      },
+    { sf::Keyboard::Num7,   AbstractController::KEY_7,      
+                            AbstractController::KEY_SEEK_7      },
+    { sf::Keyboard::Num8,   AbstractController::KEY_8,      
+                            AbstractController::KEY_SEEK_8      },
+    { sf::Keyboard::Num9,   AbstractController::KEY_9,      
+                            AbstractController::KEY_SEEK_9      },
+    { sf::Keyboard::Delete, AbstractController::KEY_DELETE, 
+                            AbstractController::KEY_DELETE      },
+    { sf::Keyboard::H,      AbstractController::KEY_HIGHLIGHT, 
+                            AbstractController::KEY_HIGHLIGHT   },
+    { sf::Keyboard::Tab,    AbstractController::KEY_NEXT_EMPTY, 
+                            AbstractController::KEY_NEXT_EMPTY  },
+    { sf::Keyboard::F,      AbstractController::KEY_NEXT_FEWEST, 
+                            AbstractController::KEY_NEXT_FEWEST }
+};
+
+///
+/// \brief The index in _keyMap for each of the system's keys, or -1 if the
+///        key isn't used. Built on the first lookup.
+///
+static int _keyTable[sf::Keyboard::KeyCount];
+
+///
+/// \brief Flag to indicate that the _keyTable has been built
+///
+static bool _hasKeyTable = false;
+
+///
+/// \brief The ring of the queued events
+///
+static InputEvent _ring[INPUTQUEUE_SIZE];
+
+///
+/// \brief The no of events that have been pushed. Only written by the 
+///        producer, with release ordering, so the consumer that reads it 
+///        with acquire ordering sees the event's slot complete.
+///
+static std::atomic<unsigned int> _writeCount(0);
+
+///
+/// \brief The no of events that have been popped. Only written by the 
+///        consumer, with release ordering, so the producer doesn't reuse 
+///        the slot before it has been read.
+///
+static std::atomic<unsigned int> _readCount(0);
+
+///
+/// \brief The clock for the input timestamps
+///
+static sf::Clock _inputClock;
+
+//-----------------------------------------------------------------------------
+sf::Time InputQueue_now() {
+    return _inputClock.getElapsedTime();
+}
+
+bool InputQueue_mapKey(const sf::Event::KeyEvent      &keyEvent, 
+                       enum AbstractController::_keys *key) {
+    if (!_hasKeyTable) {
+        for (unsigned int i = 0; i < sf::Keyboard::KeyCount; i++) {
+            _keyTable[i] = -1;
+        }
+
+        for (unsigned int i = 0; i < sizeof(_keyMap) / sizeof(_keyMap[0]); 
+             i++) {
+            _keyTable[_keyMap[i].code] = i;
+        }
+
+        _hasKeyTable = true;
+    }
+
+    if ((keyEvent.code < 0) || (keyEvent.code >= sf::Keyboard::KeyCount) ||
+        (_keyTable[keyEvent.code] < 0)) {
+        // Other keyboard input. Ignore it.
+        return false;
+    }
+
+    const InputQueueKeyMap *keyMap = &_keyMap[_keyTable[keyEvent.code]];
+    *key = keyEvent.shift ? keyMap->shiftKey : keyMap->key;
+
+    return true;
+}
+
+bool InputQueue_push(enum AbstractController::_keys key, sf::Time timestamp) {
+    unsigned int writeCount = _writeCount.load(std::memory_order_relaxed);
+    unsigned int readCount  = _readCount.load(std::memory_order_acquire);
+
+    if ((writeCount - readCount) >= INPUTQUEUE_SIZE) {
+        // The game loop hasn't drained the queue for too long
+        return false;
+    }
+
+    InputEvent *inputEvent = &_ring[writeCount & (INPUTQUEUE_SIZE - 1)];
+    inputEvent->key       = key;
+    inputEvent->timestamp = timestamp;
+
+    // Publish the event only after it's complete
+    _writeCount.store(writeCount + 1, std::memory_order_release);
+
+    return true;
+}
+
+bool InputQueue_pop(InputEvent *inputEvent) {
+    if (!InputQueue_peek(inputEvent)) {
+        return false;
+    }
+
+    // Release the slot only after it has been read
+    _readCount.store(_readCount.load(std::memory_order_relaxed) + 1, 
+                     std::memory_order_release);
+
+    return true;
+}
+
+bool InputQueue_peek(InputEvent *inputEvent) {
+    unsigned int readCount  = _readCount.load(std::memory_order_relaxed);
+    unsigned int writeCount = _writeCount.load(std::memory_order_acquire);
+
+    if (readCount == writeCount) {
+        return false;
+    }
+
+    *inputEvent = _ring[readCount & (INPUTQUEUE_SIZE - 1)];
+
+    return true;
+}
@@ -0,0 +1,334 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+#include "jobsystem.h"
+
+#if defined(SFML_SYSTEM_WINDOWS)
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+///
+/// \brief The maximum no of worker threads
+///
+#define JOBSYSTEM_MAX_WORKERS       8
+
+///
+/// \brief The queued jobs for each priority, in the submission order
+///
+static std::deque<AbstractJob *> _queuedJobs[JOB_PRIORITY_COUNT];
+
+///
+/// \brief The jobs that have finished running, in the finishing order
+///
+static std::deque<AbstractJob *> _finishedJobs;
+
+///
+/// \brief All of the jobs that haven't been completed yet
+///
+static std::map<JobId, AbstractJob *> _pendingJobs;
+
+///
+/// \brief The jobs that have been cancelled while running / finished
+///
+static std::set<AbstractJob *> _cancelledJobs;
+
+///
+/// \brief The last assigned job id
+///
+static JobId _lastJobId = 0;
+
+///
+/// \brief The worker threads
+///
+static std::vector<sf::Thread *> _workers;
+
+///
+/// \brief Flag to keep the worker threads running
+///
+static bool _workersAreRunning = false;
+
+///
+/// \brief Protect all of the job system's data
+///
+static std::mutex _jobMutex;
+
+///
+/// \brief Wake up the idle workers when a job is queued, or when they have 
+///        to stop
+///
+static std::condition_variable _jobSignal;
+
+//-----------------------------------------------------------------------------
+///
+/// \brief Get the no of processors
+///
+static unsigned int JobSystem_processorCount() {
+#if defined(SFML_SYSTEM_WINDOWS)
+    SYSTEM_INFO systemInfo;
+    GetSystemInfo(&systemInfo);
+
+    return systemInfo.dwNumberOfProcessors;
+#else
+    long processorCount = sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (processorCount > 0) ? (unsigned int) processorCount : 1;
+#endif
+}
+
+///
+/// \brief Take the queued job with the highest priority. Called with the 
+///        job mutex locked.
+///
+/// \return The job, or NULL if there's no queued job
+///
+static AbstractJob *JobSystem_takeQueuedJob() {
+    for (unsigned int i = 0; i < JOB_PRIORITY_COUNT; i++) {
+        if (!_queuedJobs[i].empty()) {
+            AbstractJob *job = _queuedJobs[i].front();
+            _queuedJobs[i].pop_front();
+
+            return job;
+        }
+    }
+
+    return NULL;
+}
+
+///
+/// \brief The worker thread. Run the queued jobs, highest priority first.
+///
+static void JobSystem_workerLoop() {
+    while (true) {
+        AbstractJob *job = NULL;
+
+        {
+            std::unique_lock<std::mutex> lock(_jobMutex);
+
+            // Sleep until there's a job to run, or the workers are stopped
+            while ((_workersAreRunning) && 
+                   ((job = JobSystem_takeQueuedJob()) == NULL)) {
+                _jobSignal.wait(lock);
+            }
+        }
+
+        if (job == NULL) {
+            break;
+        }
+
+        job->run();
+
+        std::lock_guard<std::mutex> lock(_jobMutex);
+        _finishedJobs.push_back(job);
+    }
+}
+
+///
+/// \brief Forget the job, and delete it. Called in the game loop's thread.
+///
+static void JobSystem_deleteJob(AbstractJob *job) {
+    {
+        std::lock_guard<std::mutex> lock(_jobMutex);
+
+        std::map<JobId, AbstractJob *>::iterator it;
+        for (it = _pendingJobs.begin(); it != _pendingJobs.end(); ++it) {
+            if (it->second == job) {
+                _pendingJobs.erase(it);
+                break;
+            }
+        }
+
+        _cancelledJobs.erase(job);
+    }
+
+    delete job;
+}
+
+//-----------------------------------------------------------------------------
+bool AbstractJob::isCancelled() {
+    std::lock_guard<std::mutex> lock(_jobMutex);
+    return (_cancelledJobs.count(this) > 0);
+}
+
+void JobSystem_init(unsigned int workerCount) {
+    if (workerCount == 0) {
+        // Leave a processor for the game loop
+        unsigned int processorCount = JobSystem_processorCount();
+        workerCount = (processorCount > 1) ? (processorCount - 1) : 1;
+    }
+
+    if (workerCount > JOBSYSTEM_MAX_WORKERS) {
+        workerCount = JOBSYSTEM_MAX_WORKERS;
+    }
+
+    _workersAreRunning = true;
+
+    for (unsigned int i = 0; i < workerCount; i++) {
+        sf::Thread *worker = new sf::Thread(&JobSystem_workerLoop);
+        worker->launch();
+        _workers.push_back(worker);
+    }
+}
+
+JobId JobSystem_submit(AbstractJob *job, enum _jobPriority priority) {
+    if (job == NULL) {
+        return 0;
+    }
+
+    if ((priority < JOB_PRIORITY_HIGH) || (priority >= JOB_PRIORITY_COUNT)) {
+        priority = JOB_PRIORITY_NORMAL;
+    }
+
+    std::lock_guard<std::mutex> lock(_jobMutex);
+
+    // 0 is never used, so it can mean "no job"
+    _lastJobId++;
+    if (_lastJobId == 0) {
+        _lastJobId++;
+    }
+
+    _pendingJobs[_lastJobId] = job;
+    _queuedJobs[priority].push_back(job);
+
+    // Wake up an idle worker to run it
+    _jobSignal.notify_one();
+
+    return _lastJobId;
+}
+
+void JobSystem_cancel(JobId id) {
+    AbstractJob *queuedJob = NULL;
+
+    {
+        std::lock_guard<std::mutex> lock(_jobMutex);
+
+        std::map<JobId, AbstractJob *>::iterator it = _pendingJobs.find(id);
+        if (it == _pendingJobs.end()) {
+            // Already completed
+            return;
+        }
+
+        AbstractJob *job = it->second;
+
+        for (unsigned int i = 0; i < JOB_PRIORITY_COUNT; i++) {
+            std::deque<AbstractJob *>::iterator queued;
+            for (queued = _queuedJobs[i].begin(); 
+                 queued != _queuedJobs[i].end(); ++queued) {
+                if (*queued == job) {
+                    _queuedJobs[i].erase(queued);
+                    queuedJob = job;
+                    break;
+                }
+            }
+
+            if (queuedJob != NULL) {
+                break;
+            }
+        }
+
+        if (queuedJob == NULL) {
+            // It's running or finished, the worker still owns it
+            _cancelledJobs.insert(job);
+        }
+    }
+
+    if (queuedJob != NULL) {
+        // Never started, it can be deleted right away
+        JobSystem_deleteJob(queuedJob);
+    }
+}
+
+void JobSystem_processCompleted(sf::Time timeBudget) {
+    sf::Clock budgetClock;
+
+    do {
+        AbstractJob *job;
+        bool         isCancelled;
+
+        {
+            std::lock_guard<std::mutex> lock(_jobMutex);
+
+            if (_finishedJobs.empty()) {
+                return;
+            }
+
+            job = _finishedJobs.front();
+            _finishedJobs.pop_front();
+            isCancelled = (_cancelledJobs.count(job) > 0);
+        }
+
+        // The job's result may change the game state, so it's used in the
+        // game loop's thread
+        if (!isCancelled) {
+            job->complete();
+        }
+
+        JobSystem_deleteJob(job);
+    } while (budgetClock.getElapsedTime() < timeBudget);
+}
+
+bool JobSystem_hasPendingJobs() {
+    std::lock_guard<std::mutex> lock(_jobMutex);
+    return (!_pendingJobs.empty());
+}
+
+void JobSystem_shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(_jobMutex);
+        _workersAreRunning = false;
+
+        // Let the running jobs stop early
+        std::map<JobId, AbstractJob *>::iterator it;
+        for (it = _pendingJobs.begin(); it != _pendingJobs.end(); ++it) {
+            _cancelledJobs.insert(it->second);
+        }
+    }
+
+    _jobSignal.notify_all();
+
+    for (unsigned int i = 0; i < _workers.size(); i++) {
+        _workers[i]->wait();
+        delete _workers[i];
+    }
+    _workers.clear();
+
+    std::map<JobId, AbstractJob *>::iterator it;
+    for (it = _pendingJobs.begin(); it != _pendingJobs.end(); ++it) {
+        delete it->second;
+    }
+
+    for (unsigned int i = 0; i < JOB_PRIORITY_COUNT; i++) {
+        _queuedJobs[i].clear();
+    }
+    _finishedJobs.clear();
+    _pendingJobs.clear();
+    _cancelledJobs.clear();
+}
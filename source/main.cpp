@@ -37,7 +37,6 @@
 #endif
 
 #include "gamemanager.h"
-#include "menustate.h"
 #include "splashscreenstate.h"
 
 #ifdef _WIN32            /* WIN32 platform specific (WinXP, Win7) */
@@ -52,8 +51,8 @@ int main(int argc,char *argv[]) {
     // Init the game manager
     GameManager_init();
 
-    // Init the sequence of the game state
-    GameManager_pushGameState(new MenuState());
+    // Init the sequence of the game state. The splash screen starts the menu
+    // when the artwork has been loaded.
     GameManager_pushGameState(new SplashScreenState());
 
     // Run the game
@@ -45,7 +45,7 @@
 MenuState::MenuState() : 
     _currentMainMenu(MENU_START) 
 {
-    _backgroundTexture.loadFromFile("artwork/sudoku-menu-background.png");
+    _backgroundTexture = SharedTexture("artwork/sudoku-menu-background.png");
 
     // Set menu item model
     for (unsigned int i = static_cast<int>(MENU_START); 
@@ -100,7 +100,7 @@ void MenuState::processKeypressEvent(enum _keys key) {
     case KEY_SELECT: {
         switch (_currentMainMenu) {
         case MenuState::MENU_PLAY:
-            GameManager_pushGameState(new SubMenuState());
+            GameManager_pushGameState(SubMenuState::create());
             break;
         case MenuState::MENU_HELP:
             break;
@@ -125,18 +125,19 @@ void MenuState::update(sf::Time elapsedTime) {
         // Each menu item in this tilemap has 2 entry. One for normal, and the
         // other for the highlighted
         if (i != static_cast<int> (_currentMainMenu)) {
-            _menuModel[i] = (i * 2);
+            _menuModelAdapter.setValue((i * 2), i, 0);
         } else {
-            _menuModel[i] = (i * 2) + 1;
+            _menuModelAdapter.setValue((i * 2) + 1, i, 0);
         }
     }
 
     _menuView.update(elapsedTime);
 }
 
-void MenuState::draw(sf::RenderWindow *win) {
-    sf::Sprite background(_backgroundTexture);
-    win->draw(background);
+void MenuState::draw(SpriteBatch *batch) {
+    sf::Sprite background(*_backgroundTexture.get(), 
+                          _backgroundTexture.getRegion());
+    batch->draw(background, SPRITE_LAYER_BACKGROUND);
 
-    _menuView.draw(win);
+    _menuView.draw(batch);
 }
@@ -0,0 +1,56 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "nullrenderbackend.h"
+
+NullRenderBackend::NullRenderBackend() {
+    reset();
+}
+
+void NullRenderBackend::drawQuads(const sf::Vertex    *vertex, 
+                                  unsigned int         vertexCount,
+                                  const sf::Texture   *texture,
+                                  const sf::Shader    *shader,
+                                  const sf::Transform &transform) {
+    if ((_drawCalls == 0) || (texture != _lastTexture)) {
+        _textureSwitches++;
+    }
+
+    if ((_drawCalls == 0) || (shader != _lastShader)) {
+        _shaderSwitches++;
+    }
+
+    _drawCalls++;
+    _vertices   += vertexCount;
+    _lastTexture = texture;
+    _lastShader  = shader;
+}
+
+void NullRenderBackend::reset() {
+    _drawCalls       = 0;
+    _vertices        = 0;
+    _textureSwitches = 0;
+    _shaderSwitches  = 0;
+    _lastTexture     = NULL;
+    _lastShader      = NULL;
+}
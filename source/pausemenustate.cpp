@@ -40,11 +40,16 @@
 ///
 #define PAUSEMENU_SCREENSIZE     sf::Vector2f(480, 320)
 
+///
+/// \brief The color that dims the paused game's frame
+///
+#define PAUSEMENU_DIM_COLOR      sf::Color(96, 96, 96)
+
 //-----------------------------------------------------------------------------
 PauseMenuState::PauseMenuState() : 
     _currentPauseMenu(PAUSEMENU_START) 
 {
-    _backgroundTexture.loadFromFile("artwork/sudoku-menu-background.png");
+    _backgroundTexture = SharedTexture("artwork/sudoku-menu-background.png");
 
     // Set menu item model
     for (unsigned int i = static_cast<int>(PAUSEMENU_START); 
@@ -126,18 +131,32 @@ void PauseMenuState::update(sf::Time elapsedTime) {
         // Each menu item in this tilemap has 2 entry. One for normal, and the
         // other for the highlighted
         if (i != static_cast<int> (_currentPauseMenu)) {
-            _pausemenuModel[i] = (i * 2);
+            _pausemenuModelAdapter.setValue((i * 2), i, 0);
         } else {
-            _pausemenuModel[i] = (i * 2) + 1;
+            _pausemenuModelAdapter.setValue((i * 2) + 1, i, 0);
         }
     }
 
     _pausemenuView.update(elapsedTime);
 }
 
-void PauseMenuState::draw(sf::RenderWindow *win) {
-    sf::Sprite background(_backgroundTexture);
-    win->draw(background);
+bool PauseMenuState::isOverlay() const {
+    return true;
+}
+
+void PauseMenuState::draw(SpriteBatch *batch) {
+    const sf::Texture *frozenFrame = GameManager_frozenFrame();
+
+    if (frozenFrame != NULL) {
+        // Show the paused game, dimmed, behind the menu
+        sf::Sprite background(*frozenFrame);
+        background.setColor(PAUSEMENU_DIM_COLOR);
+        batch->draw(background, SPRITE_LAYER_BACKGROUND);
+    } else {
+        sf::Sprite background(*_backgroundTexture.get(), 
+                              _backgroundTexture.getRegion());
+        batch->draw(background, SPRITE_LAYER_BACKGROUND);
+    }
 
-    _pausemenuView.draw(win);
+    _pausemenuView.draw(batch);
 }
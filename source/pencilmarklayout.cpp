@@ -0,0 +1,94 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include "pencilmarklayout.h"
+
+PencilMarkLayout::PencilMarkLayout(BoardModelAdapter *board, 
+                                   sf::Vector2u       tileSize,
+                                   sf::Vector2u       markSize,
+                                   sf::Vector2f       screenSize, 
+                                   sf::Vector2f       screenOffset) :
+    SudokuBoardLayout(board, tileSize, screenSize, screenOffset),
+    _markSize(markSize)
+{
+}
+
+PencilMarkLayout::~PencilMarkLayout() {
+}
+
+sf::Vector2f PencilMarkLayout::markPositionInScreen(int          row, 
+                                                    int          column, 
+                                                    unsigned int digit) {
+    // The marks in the tile use the same grid as the sub-board:
+    //    1 2 3
+    //    4 5 6
+    //    7 8 9
+    // with digit #5 in the center of the tile
+    unsigned int marksPerRow = this->marksPerRow();
+
+    float markColumn = (float) ((digit - 1) % marksPerRow);
+    float markRow    = (float) ((digit - 1) / marksPerRow);
+    float center     = (marksPerRow - 1) / 2.f;
+
+    sf::Vector2f tilePos  = tilePositionInScreen(row, column);
+    sf::Vector2f cellSize = markCellSize();
+
+    tilePos.x += (markColumn - center) * cellSize.x;
+    tilePos.y += (markRow    - center) * cellSize.y;
+
+    return tilePos;
+}
+
+sf::Vector2u PencilMarkLayout::markSize() const {
+    return _markSize;
+}
+
+sf::Vector2f PencilMarkLayout::markSizeInScreen() const {
+    sf::Vector2f cellSize = markCellSize();
+
+    return sf::Vector2f(std::min((float) _markSize.x, cellSize.x),
+                        std::min((float) _markSize.y, cellSize.y));
+}
+
+unsigned int PencilMarkLayout::marksPerRow() const {
+    unsigned int marksPerRow = 1;
+
+    if (_board == NULL) {
+        return marksPerRow;
+    }
+
+    while (((marksPerRow + 1) * (marksPerRow + 1)) <= _board->columnSize()) {
+        marksPerRow++;
+    }
+
+    return marksPerRow;
+}
+
+sf::Vector2f PencilMarkLayout::markCellSize() const {
+    // The marks share the tile evenly, e.g. 24px / 3 = 8px on 9x9 board, 
+    // 6px on 16x16 board, and 4.8px on 25x25 board
+    float marksPerRow = (float) this->marksPerRow();
+
+    return sf::Vector2f(_tileSize.x / marksPerRow, _tileSize.y / marksPerRow);
+}
@@ -0,0 +1,159 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include "pencilmarkview.h"
+#include "dirtyregion.h"
+
+PencilMarkView::PencilMarkView(const SudokuCandidateGrid *grid,
+                               PencilMarkLayout          *layout,
+                               const std::string         &tilemapFilename) :
+    _grid(grid),
+    _faceTable(NULL),
+    _marksPerTile(0),
+    _gridVersion(0)
+{
+    // Load the pencil mark texture
+    _markTexture = SharedTexture(tilemapFilename);
+
+    if ((grid == NULL) || (layout == NULL)) {
+        return;
+    }
+
+    unsigned int boardSize = _grid->boardSize();
+    unsigned int tileCount = boardSize * boardSize;
+
+    _transform        = layout->screenTransform();
+    _markSize         = layout->markSize();
+    _markSizeInScreen = layout->markSizeInScreen();
+    _marksPerTile     = boardSize;
+    _faceTable        = TileFaceTable::get(_markTexture.getSize(), 
+                                           _markSize, 
+                                           _markTexture.getOffset());
+
+    for (unsigned int tile = 0; tile < tileCount; tile++) {
+        for (unsigned int digit = 1; digit <= _marksPerTile; digit++) {
+            _markPosition.push_back(
+                layout->markPositionInScreen(tile / boardSize, 
+                                             tile % boardSize, 
+                                             digit)
+            );
+        }
+    }
+
+    // Every mark gets its own quad, so changing a tile never moves the other
+    // tiles' vertex. Hidden marks are collapsed into a single point.
+    _vertex.resize(tileCount * _marksPerTile * 4);
+
+    // Force the first update to generate all of the marks
+    _tileMask = std::vector<unsigned int> (tileCount, (unsigned int) -1);
+    _gridVersion = _grid->version() - 1;
+}
+
+void PencilMarkView::update(sf::Time elapsedTime) {
+    if ((_grid == NULL) || (_gridVersion == _grid->version())) {
+        // The candidates haven't changed since the last update
+        return;
+    }
+
+    unsigned int boardSize = _grid->boardSize();
+
+    for (unsigned int tile = 0; tile < _tileMask.size(); tile++) {
+        unsigned int mask = 
+            _grid->candidateMask(tile / boardSize, tile % boardSize);
+
+        if (mask != _tileMask[tile]) {
+            _tileMask[tile] = mask;
+            updateTileMarks(tile);
+
+            // Redraw the area that's covered by the tile's marks
+            unsigned int firstMark = tile * _marksPerTile;
+            unsigned int lastMark  = firstMark + _marksPerTile - 1;
+            float left   = std::min(_markPosition[firstMark].x, 
+                                    _markPosition[lastMark].x);
+            float top    = std::min(_markPosition[firstMark].y, 
+                                    _markPosition[lastMark].y);
+            float right  = std::max(_markPosition[firstMark].x, 
+                                    _markPosition[lastMark].x);
+            float bottom = std::max(_markPosition[firstMark].y, 
+                                    _markPosition[lastMark].y);
+
+            DirtyRegion_add(_transform.transformRect(sf::FloatRect(
+                left - (_markSizeInScreen.x / 2.f),
+                top  - (_markSizeInScreen.y / 2.f),
+                (right  - left) + _markSizeInScreen.x,
+                (bottom - top)  + _markSizeInScreen.y
+            )));
+        }
+    }
+
+    _gridVersion = _grid->version();
+}
+
+void PencilMarkView::draw(SpriteBatch *batch) {
+    // Don't draw if it's not supposed to be shown
+    if ((!_isShowed) || (_vertex.empty())) {
+        return;
+    }
+
+    batch->draw(&_vertex[0], 
+                _vertex.size(), 
+                _markTexture.get(), 
+                _layer,
+                _transform);
+}
+
+void PencilMarkView::updateTileMarks(unsigned int tile) {
+    for (unsigned int digit = 1; digit <= _marksPerTile; digit++) {
+        unsigned int  mark   = (tile * _marksPerTile) + (digit - 1);
+        sf::Vertex   *vertex = &_vertex[mark * 4];
+
+        if ((_tileMask[tile] & (1u << digit)) == 0) {
+            // No candidate, collapse the quad so nothing is drawn
+            for (unsigned int i = 0; i < 4; i++) {
+                vertex[i].position  = _markPosition[mark];
+                vertex[i].texCoords = sf::Vector2f(0, 0);
+            }
+            continue;
+        }
+
+        // The texture's mark is scaled to the mark's size on the screen
+        float left   = _markPosition[mark].x - (_markSizeInScreen.x / 2.f);
+        float top    = _markPosition[mark].y - (_markSizeInScreen.y / 2.f);
+        float right  = left + _markSizeInScreen.x;
+        float bottom = top  + _markSizeInScreen.y;
+
+        // Tile #n in the tilemap is the mark for digit n
+        const sf::Vector2f *texCoords = _faceTable->texCoords(digit);
+
+        vertex[0].position  = sf::Vector2f( left,    top);
+        vertex[1].position  = sf::Vector2f(right,    top);
+        vertex[2].position  = sf::Vector2f(right, bottom);
+        vertex[3].position  = sf::Vector2f( left, bottom);
+
+        vertex[0].texCoords = texCoords[0];
+        vertex[1].texCoords = texCoords[1];
+        vertex[2].texCoords = texCoords[2];
+        vertex[3].texCoords = texCoords[3];
+    }
+}
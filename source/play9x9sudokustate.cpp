@@ -21,7 +21,9 @@
  * IN THE SOFTWARE.
  */
 
+#include <cmath>
 #include "gamemanager.h"
+#include "gamestatepool.h"
 #include "pausemenustate.h"
 #include "play9x9sudokustate.h"
 #include "gameoverstate.h"
@@ -32,6 +34,12 @@
 ///
 #define SUDOKU_BOARD_COLUMN_SIZE    9
 
+///
+/// \brief No of tiles in the Sudoku board
+///
+#define SUDOKU_BOARD_TILE_COUNT     \
+    (SUDOKU_BOARD_COLUMN_SIZE * SUDOKU_BOARD_COLUMN_SIZE)
+
 ///
 /// \brief The sudoku tile size
 ///
@@ -42,6 +50,11 @@
 ///
 #define SUDOKU_BOARD_SCREEN_SIZE    sf::Vector2f(320, 320)
 
+///
+/// \brief The pencil mark (candidate) size inside the sudoku tile
+///
+#define SUDOKU_PENCILMARK_SIZE      sf::Vector2u(8, 8)
+
 //-----------------------------------------------------------------------------
 ///
 /// \brief The sudoku board's cursor size
@@ -54,6 +67,11 @@
 ///
 #define KEYPAD_COLUMN_SIZE          3
 
+///
+/// \brief The maximum no of tiles in the keypad (9 digits + delete symbol)
+///
+#define KEYPAD_MODEL_SIZE           10
+
 ///
 /// \brief The keypad tile size
 ///
@@ -87,10 +105,48 @@
 ///
 #define TILEMAP_SYMBOL_DELETE 11
 
+///
+/// \brief The game state's pool name (see gamestatepool.h)
+///
+#define PLAYSTATE_POOL_NAME     "Play9x9SudokuState"
+
 //-----------------------------------------------------------------------------
-Play9x9SudokuState::Play9x9SudokuState() {
+///
+/// \brief The puzzle that's played
+///
+static const unsigned int _sudokuPuzzle[SUDOKU_BOARD_TILE_COUNT] = {
+    8, 0, 0, 3, 5, 4, 0, 9, 0,
+    2, 0, 0, 6, 7, 0, 8, 0, 0,
+    0, 6, 0, 8, 1, 0, 0, 3, 0,
+    0, 0, 3, 9, 2, 0, 0, 0, 4,
+    0, 9, 0, 0, 0, 0, 0, 2, 0,
+    6, 0, 0, 0, 3, 8, 1, 0, 0,
+    0, 4, 0, 0, 9, 6, 0, 5, 0,
+    0, 0, 2, 0, 8, 3, 0, 0, 6,
+    0, 5, 0, 7, 4, 1, 0, 0, 3
+};
+
+///
+/// \brief The textures that are used in this game state
+///
+static const char *_playStateTextures[] = {
+    "artwork/sudoku-game-background.png",
+    "artwork/sudoku-numbertiles-black-24px.png",
+    "artwork/sudoku-numbertiles-24px.png",
+    "artwork/sudoku-pencilmarks-8px.png",
+    "artwork/sudoku-cursor-36px.png"
+};
+
+//-----------------------------------------------------------------------------
+Play9x9SudokuState::Play9x9SudokuState() :
+    _staticLayer(NULL),
+    _shaderBoardView(NULL),
+    _isGraphicsLoaded(false),
+    _isStaticLayerStale(true),
+    _highlightConflicts(false)
+{
     // Load background texture
-    _backgroundTexture.loadFromFile("artwork/sudoku-game-background.png");
+    _backgroundTexture = SharedTexture("artwork/sudoku-game-background.png");
 
     //-------------------------------------------------------------------------
     // Create Sudoku puzzle
@@ -113,6 +169,7 @@ Play9x9SudokuState::Play9x9SudokuState() {
                   &_sudokuLayout, 
                   "artwork/sudoku-numbertiles-black-24px.png"
         );
+    _sudokuView.setLayer(SPRITE_LAYER_GIVEN);
     _sudokuView.show();
 
     _sudokuUserView = 
@@ -122,6 +179,35 @@ Play9x9SudokuState::Play9x9SudokuState() {
         );
     _sudokuUserView.show();
 
+    //-------------------------------------------------------------------------
+    // Create the pencil marks (auto-notes) for the empty tiles
+    _pencilMarkLayout = 
+        PencilMarkLayout(&_sudokuModelAdapter, 
+                         SUDOKU_TILESIZE, 
+                         SUDOKU_PENCILMARK_SIZE,
+                         SUDOKU_BOARD_SCREEN_SIZE
+        );
+
+    _pencilMarkView = 
+        PencilMarkView(_sudokuGame.candidateGrid(), 
+                       &_pencilMarkLayout, 
+                       "artwork/sudoku-pencilmarks-8px.png"
+        );
+    _pencilMarkView.setLayer(SPRITE_LAYER_MARK);
+    _pencilMarkView.show();
+
+    //-------------------------------------------------------------------------
+    // Create the conflict highlight. It's shown in highlight conflicts mode,
+    // and while the conflicts that are placed in that mode are left
+    _pendingScoreTiles = Bitboard(SUDOKU_BOARD_TILE_COUNT);
+
+    _conflictView = 
+        ConflictView(_sudokuGame.candidateGrid(), 
+                     &_sudokuLayout
+        );
+    _conflictView.setLayer(SPRITE_LAYER_OVERLAY);
+    _conflictView.hide();
+
     //-------------------------------------------------------------------------
     // Create board's cursor
     _sudokuCursorModel = sf::Vector2u(0, 0);
@@ -130,6 +216,7 @@ Play9x9SudokuState::Play9x9SudokuState() {
         CursorView(SUDOKU_CURSOR_SIZE, 
                    "artwork/sudoku-cursor-36px.png"
         );
+    _sudokuCursorView.setLayer(SPRITE_LAYER_CURSOR);
     _sudokuCursorView.show();
 
     _sudokuCursorController = 
@@ -141,7 +228,11 @@ Play9x9SudokuState::Play9x9SudokuState() {
     _sudokuCursorController.registerEventObserver(this);
 
     //-------------------------------------------------------------------------
-    // Create keypad with all the combination tiles
+    // Create keypad with all the combination tiles. The keypad model is 
+    // rewritten in place everytime the keypad is opened, so reserve its 
+    // full size once.
+    _keypadModel.reserve(KEYPAD_MODEL_SIZE);
+
     for (unsigned int i = 1; i <= 9; i++) {
         _keypadModel.push_back(i);
     }
@@ -199,20 +290,132 @@ Play9x9SudokuState::Play9x9SudokuState() {
 
 Play9x9SudokuState::~Play9x9SudokuState() {
     delete _sudokuScore;
+    delete _shaderBoardView;
+    delete _staticLayer;
+}
+
+void Play9x9SudokuState::textureFilenames(std::vector<std::string> *names) {
+    for (unsigned int i = 0; 
+         i < sizeof(_playStateTextures) / sizeof(_playStateTextures[0]); i++) {
+        names->push_back(_playStateTextures[i]);
+    }
+}
+
+Play9x9SudokuState *Play9x9SudokuState::create() {
+    Play9x9SudokuState *state = static_cast<Play9x9SudokuState *>(
+        GameStatePool_acquire(PLAYSTATE_POOL_NAME));
+
+    if (state == NULL) {
+        return new Play9x9SudokuState();
+    }
+
+    state->reset(_sudokuPuzzle);
+
+    return state;
+}
+
+void Play9x9SudokuState::reset(const unsigned int *puzzle) {
+    loadPuzzle(puzzle);
+    _sudokuGame.reset();
+    _sudokuModelAdapter.markChanged();
+
+    _sudokuScore->reset();
+
+    // Start from the board's cursor, with the keypad closed
+    _keypadCursorView.hide();
+    _keypadView.hide();
+    _currentCursorController = &_sudokuCursorController;
+    _sudokuCursorController.resetCursorPosition();
+
+    _highlightConflicts = false;
+    _conflictView.hide();
+    _pendingScoreTiles.clear();
+
+    // The static layer still shows the old puzzle. It's redrawn in 
+    // loadGraphics(), since this may be called in a worker thread.
+    _isStaticLayerStale = true;
+}
+
+const char *Play9x9SudokuState::poolName() const {
+    return PLAYSTATE_POOL_NAME;
+}
+
+void Play9x9SudokuState::loadGraphics() {
+    if (!_isGraphicsLoaded) {
+        _isGraphicsLoaded = true;
+
+        // Draw the whole board (puzzle and user's tiles) with a single quad,
+        // if the graphic card supports shaders
+        if (sf::Shader::isAvailable()) {
+            _shaderBoardView = new ShaderBoardView(
+                &_sudokuModelAdapter, 
+                &_sudokuLayout, 
+                "artwork/sudoku-numbertiles-black-24px.png",
+                "artwork/sudoku-numbertiles-24px.png"
+            );
+
+            if (_shaderBoardView->isLoaded()) {
+                _shaderBoardView->setLayer(SPRITE_LAYER_GIVEN);
+                _shaderBoardView->show();
+            } else {
+                // Fallback to the tile views
+                delete _shaderBoardView;
+                _shaderBoardView = NULL;
+            }
+        }
+
+        // The static layer is kept when the game state is reused
+        sf::Vector2u layerSize = _backgroundTexture.getSize();
+
+        _staticLayer = new sf::RenderTexture();
+        if (!_staticLayer->create(layerSize.x, layerSize.y)) {
+            // Fallback to drawing the background and the puzzle every frame
+            delete _staticLayer;
+            _staticLayer = NULL;
+        }
+    }
+
+    if (_isStaticLayerStale) {
+        // The puzzle is loaded, render the parts that don't change
+        renderStaticLayer();
+        _isStaticLayerStale = false;
+    }
 }
 
 void Play9x9SudokuState::processKeypressEvent(enum _keys key) {
+    if (key == KEY_HIGHLIGHT) {
+        // Toggle the highlight conflicts mode
+        _highlightConflicts = !_highlightConflicts;
+        updateConflictView();
+        return;
+    }
+
+    // The navigation keys are only used by the sudoku board's cursor
+    if ((_currentCursorController == &_sudokuCursorController) &&
+        (navigateCursor(key))) {
+        return;
+    }
+
     _currentCursorController->processKeypressEvent(key);
 }
 
 void Play9x9SudokuState::update(sf::Time elapsedTime) {
     _sudokuCursorView.update(elapsedTime);
 
-    _sudokuModelAdapter.disableMask();
-    _sudokuView.update(elapsedTime);
+    if (_shaderBoardView != NULL) {
+        _shaderBoardView->update(elapsedTime);
+    } else {
+        if (_staticLayer == NULL) {
+            _sudokuModelAdapter.disableMask();
+            _sudokuView.update(elapsedTime);
+            _sudokuModelAdapter.enableMask();
+        }
+
+        _sudokuUserView.update(elapsedTime);
+    }
 
-    _sudokuModelAdapter.enableMask();
-    _sudokuUserView.update(elapsedTime);
+    _pencilMarkView.update(elapsedTime);
+    _conflictView.update(elapsedTime);
 
     _keypadCursorView.update(elapsedTime);
     _keypadView.update(elapsedTime);
@@ -220,19 +423,67 @@ void Play9x9SudokuState::update(sf::Time elapsedTime) {
     _sudokuScore->update(elapsedTime);
 }
 
-void Play9x9SudokuState::draw(sf::RenderWindow *win) {
-    // Draw background sprite
-    sf::Sprite backgroundSprite(_backgroundTexture);
-    win->draw(backgroundSprite);
+sf::Time Play9x9SudokuState::timeToNextUpdate() {
+    // The board only changes on input, but the score keeps counting down
+    return _sudokuScore->timeToNextUpdate();
+}
+
+void Play9x9SudokuState::draw(SpriteBatch *batch) {
+    if (_staticLayer != NULL) {
+        // Draw the background (and the puzzle, if there's no shader board)
+        sf::Sprite staticSprite(_staticLayer->getTexture());
+        batch->draw(staticSprite, SPRITE_LAYER_BACKGROUND);
+    } else {
+        // Draw background sprite
+        sf::Sprite backgroundSprite(*_backgroundTexture.get(), 
+                                    _backgroundTexture.getRegion());
+        batch->draw(backgroundSprite, SPRITE_LAYER_BACKGROUND);
+    }
+
+    _sudokuCursorView.draw(batch);
+
+    if (_shaderBoardView != NULL) {
+        _shaderBoardView->draw(batch);
+    } else {
+        if (_staticLayer != NULL) {
+            // The cursor is drawn below the puzzle's tiles. Put the tile 
+            // under the cursor back on top of it.
+            sf::Vector2u tileSize = _sudokuLayout.tileSize();
+            sf::Vector2f tilePos  = 
+                _sudokuLayout.tilePositionInScreen(_sudokuCursorModel.y,
+                                                   _sudokuCursorModel.x);
+            sf::FloatRect tileArea = 
+                _sudokuLayout.screenTransform().transformRect(sf::FloatRect(
+                    tilePos.x - (tileSize.x / 2), 
+                    tilePos.y - (tileSize.y / 2), 
+                    (float) tileSize.x, 
+                    (float) tileSize.y
+                ));
+            sf::IntRect   tileRect(
+                (int) std::floor(tileArea.left),
+                (int) std::floor(tileArea.top),
+                (int) std::ceil(tileArea.width),
+                (int) std::ceil(tileArea.height)
+            );
+
+            sf::Sprite tileSprite(_staticLayer->getTexture(), tileRect);
+            tileSprite.setPosition((float) tileRect.left, 
+                                   (float) tileRect.top);
+            batch->draw(tileSprite, SPRITE_LAYER_GIVEN);
+        } else {
+            _sudokuView.draw(batch);
+        }
 
-    _sudokuCursorView.draw(win);
-    _sudokuView.draw(win);
-    _sudokuUserView.draw(win);
+        _sudokuUserView.draw(batch);
+    }
+
+    _conflictView.draw(batch);
+    _pencilMarkView.draw(batch);
 
-    _keypadCursorView.draw(win);
-    _keypadView.draw(win);
+    _keypadCursorView.draw(batch);
+    _keypadView.draw(batch);
 
-    _sudokuScore->draw(win);
+    _sudokuScore->draw(batch);
 }
 
 void Play9x9SudokuState::tileSelected(AbstractController       *controller,
@@ -322,22 +573,40 @@ void Play9x9SudokuState::tileSelected(AbstractController       *controller,
         // over check
     }
 
-    if (_sudokuGame.isDigitValid(tileValue, 
-                                 _sudokuCursorModel.y, 
-                                 _sudokuCursorModel.x)) 
+    // Erasing a tile never creates a conflict. In highlight conflicts mode,
+    // the conflicting digit is placed and highlighted instead of rejected.
+    if ((tileValue == 0) || 
+        (_highlightConflicts) ||
+        (_sudokuGame.isDigitValid(tileValue, 
+                                  _sudokuCursorModel.y, 
+                                  _sudokuCursorModel.x))) 
     { 
         _sudokuModelAdapter.setValue(tileValue, 
                                      _sudokuCursorModel.y,
                                      _sudokuCursorModel.x
         );
+        _sudokuGame.updateTile(_sudokuCursorModel.y, _sudokuCursorModel.x);
+
+        unsigned int tile = (_sudokuCursorModel.y * SUDOKU_BOARD_COLUMN_SIZE) +
+                            _sudokuCursorModel.x;
+        _pendingScoreTiles.reset(tile);
 
         // Get a score when the tileValue is not 0 (not erasing the current
-        // value)
+        // value), and the digit is not in conflict. A conflicting digit is
+        // scored once its conflict is cleared.
         if (tileValue > 0) {
-            _sudokuScore->updateScore(_sudokuCursorModel.y,
-                                      _sudokuCursorModel.x);
+            if (!_sudokuGame.candidateGrid()->isInConflict(
+                    _sudokuCursorModel.y, _sudokuCursorModel.x)) {
+                _sudokuScore->updateScore(_sudokuCursorModel.y,
+                                          _sudokuCursorModel.x);
+            } else {
+                _pendingScoreTiles.set(tile);
+            }
         }
 
+        scoreResolvedConflicts();
+        updateConflictView();
+
         if (_sudokuGame.isGameOver()) {
             GameManager_pushGameState(new GameOverState(_sudokuScore->totalScore()));
         }
@@ -345,11 +614,105 @@ void Play9x9SudokuState::tileSelected(AbstractController       *controller,
 }
 
 //-----------------------------------------------------------------------------
+bool Play9x9SudokuState::navigateCursor(enum _keys key) {
+    const SudokuCandidateGrid *grid = _sudokuGame.candidateGrid();
+    int tile;
+
+    switch (key) {
+    case KEY_NEXT_EMPTY: {
+        tile = grid->nextEmptyTile(_sudokuCursorModel.y, 
+                                   _sudokuCursorModel.x);
+        break;
+    }
+    case KEY_NEXT_FEWEST: {
+        tile = grid->nextFewestCandidateTile(_sudokuCursorModel.y, 
+                                             _sudokuCursorModel.x);
+        break;
+    }
+    case KEY_SEEK_1: // fall through
+    case KEY_SEEK_2: // fall through
+    case KEY_SEEK_3: // fall through
+    case KEY_SEEK_4: // fall through
+    case KEY_SEEK_5: // fall through
+    case KEY_SEEK_6: // fall through
+    case KEY_SEEK_7: // fall through
+    case KEY_SEEK_8: // fall through
+    case KEY_SEEK_9: {
+        tile = grid->nextTileAccepting((key - KEY_SEEK_1) + 1,
+                                       _sudokuCursorModel.y, 
+                                       _sudokuCursorModel.x);
+        break;
+    }
+    default: {
+        // Not a navigation key
+        return false;
+    }
+    }
+
+    if (tile >= 0) {
+        _sudokuCursorController.moveCursorTo(tile / SUDOKU_BOARD_COLUMN_SIZE,
+                                             tile % SUDOKU_BOARD_COLUMN_SIZE);
+    } else {
+        // No tile is matching, keep the cursor where it is
+    }
+
+    return true;
+}
+
+void Play9x9SudokuState::scoreResolvedConflicts() {
+    if (_pendingScoreTiles.count() == 0) {
+        return;
+    }
+
+    const SudokuCandidateGrid *grid = _sudokuGame.candidateGrid();
+
+    for (unsigned int tile = 0; tile < SUDOKU_BOARD_TILE_COUNT; tile++) {
+        unsigned int row    = tile / SUDOKU_BOARD_COLUMN_SIZE;
+        unsigned int column = tile % SUDOKU_BOARD_COLUMN_SIZE;
+
+        if ((_pendingScoreTiles.test(tile)) && 
+            (!grid->isInConflict(row, column))) {
+            _pendingScoreTiles.reset(tile);
+            _sudokuScore->updateScore(row, column);
+        }
+    }
+}
+
+void Play9x9SudokuState::updateConflictView() {
+    // The conflicts that are left after the highlight conflicts mode is 
+    // turned off stay highlighted, since the game can't be finished until 
+    // they are fixed
+    if ((_highlightConflicts) || 
+        (_sudokuGame.candidateGrid()->conflictCount() > 0)) {
+        _conflictView.show();
+    } else {
+        _conflictView.hide();
+    }
+}
+
 void Play9x9SudokuState::createKeypad() {
-    _keypadModel = 
-        _sudokuGame.availableDigit(_sudokuCursorModel.y, 
-                                   _sudokuCursorModel.x
-        );
+    unsigned int digitMask = 0;
+
+    if (_highlightConflicts) {
+        // Offer all digits, the conflicts will be highlighted
+        for (unsigned int i = 1; i <= 9; i++) {
+            digitMask |= (1u << i);
+        }
+    } else {
+        digitMask = 
+            _sudokuGame.availableDigitMask(_sudokuCursorModel.y, 
+                                           _sudokuCursorModel.x
+            );
+    }
+
+    // Rewrite the keypad model in place. It never grows beyond the reserved
+    // size, so no memory is allocated here.
+    _keypadModel.clear();
+
+    while (digitMask != 0) {
+        _keypadModel.push_back(Bitboard::lowestBit(digitMask));
+        digitMask &= (digitMask - 1);
+    }
 
     _keypadModel.push_back(TILEMAP_SYMBOL_DELETE);
 
@@ -357,30 +720,46 @@ void Play9x9SudokuState::createKeypad() {
 }
 
 void Play9x9SudokuState::createSudokuBoard() {
-    unsigned int suzokuPuzzle[] = {
-        8, 0, 0, 3, 5, 4, 0, 9, 0,
-        2, 0, 0, 6, 7, 0, 8, 0, 0,
-        0, 6, 0, 8, 1, 0, 0, 3, 0,
-        0, 0, 3, 9, 2, 0, 0, 0, 4,
-        0, 9, 0, 0, 0, 0, 0, 2, 0,
-        6, 0, 0, 0, 3, 8, 1, 0, 0,
-        0, 4, 0, 0, 9, 6, 0, 5, 0,
-        0, 0, 2, 0, 8, 3, 0, 0, 6,
-        0, 5, 0, 7, 4, 1, 0, 0, 3
-    };
-
-    _sudokuModel.insert(_sudokuModel.begin(),
-                        std::begin(suzokuPuzzle), 
-                        std::end  (suzokuPuzzle)
-    );
-
-    for (unsigned int i = 0; i < _sudokuModel.size(); i++) {
-        if (_sudokuModel[i] > 0) {
-            _sudokuModelMask.push_back(true);
-        } else {
-            _sudokuModelMask.push_back(false);
-        }
-    }
+    _sudokuModel.resize(SUDOKU_BOARD_TILE_COUNT);
+    _sudokuModelMask.resize(SUDOKU_BOARD_TILE_COUNT);
+
+    loadPuzzle(_sudokuPuzzle);
 
     _sudokuGame = SudokuGame(&_sudokuModel);
 }
+
+void Play9x9SudokuState::loadPuzzle(const unsigned int *puzzle) {
+    // The model is rewritten in place, the adapters and the game keep 
+    // pointing to it
+    for (unsigned int i = 0; i < SUDOKU_BOARD_TILE_COUNT; i++) {
+        _sudokuModel[i]     = puzzle[i];
+        _sudokuModelMask[i] = (puzzle[i] > 0);
+    }
+}
+
+void Play9x9SudokuState::renderStaticLayer() {
+    if (_staticLayer == NULL) {
+        // No render texture support, keep drawing everything every frame
+        return;
+    }
+
+    SpriteBatch batch;
+
+    sf::Sprite backgroundSprite(*_backgroundTexture.get(), 
+                                _backgroundTexture.getRegion());
+    batch.draw(backgroundSprite, SPRITE_LAYER_BACKGROUND);
+
+    if (_shaderBoardView == NULL) {
+        // Show the whole puzzle, the user's tiles will be drawn on top of it.
+        // The shader board draws the puzzle by itself.
+        _sudokuModelAdapter.disableMask();
+        _sudokuView.update(sf::Time::Zero);
+        _sudokuModelAdapter.enableMask();
+
+        _sudokuView.draw(&batch);
+    }
+
+    _staticLayer->clear();
+    batch.flush(_staticLayer);
+    _staticLayer->display();
+}
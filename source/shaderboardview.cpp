@@ -0,0 +1,293 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "dirtyregion.h"
+#include "shaderboardview.h"
+
+///
+/// \brief The max board size (in tiles) that's supported by the shader. It 
+///        must match the loop count in the shader.
+///
+#define SHADERBOARD_MAX_SIZE        32
+
+///
+/// \brief The board fragment shader. 
+///
+/// The quad's texture coordinates are the positions relative to the board's
+/// top-left corner, before the layout's transform. The shader finds the
+/// column / row whose tile covers the pixel, reads the tile face from the
+/// tile data, and samples the face from one of the tilemaps.
+///
+static const char *_boardFragmentShader = 
+    "#version 110\n"
+    "uniform sampler2D tiles;\n"
+    "uniform sampler2D tileLayout;\n"
+    "uniform sampler2D givenTilemap;\n"
+    "uniform sampler2D userTilemap;\n"
+    "uniform float boardSize;\n"
+    "uniform vec2  tileSize;\n"
+    "uniform vec2  givenOffset;\n"
+    "uniform vec2  givenTextureSize;\n"
+    "uniform float givenColumns;\n"
+    "uniform vec2  userOffset;\n"
+    "uniform vec2  userTextureSize;\n"
+    "uniform float userColumns;\n"
+    "\n"
+    "float decode(float high, float low) {\n"
+    "    return (floor(high * 255.0 + 0.5) * 256.0) +\n"
+    "           floor(low * 255.0 + 0.5);\n"
+    "}\n"
+    "\n"
+    "void main() {\n"
+    "    vec2 pixel  = gl_TexCoord[0].xy;\n"
+    "    vec2 tile   = vec2(-1.0, -1.0);\n"
+    "    vec2 corner = vec2(0.0, 0.0);\n"
+    "\n"
+    "    for (int i = 0; i < 32; i++) {\n"
+    "        if (float(i) >= boardSize) {\n"
+    "            break;\n"
+    "        }\n"
+    "\n"
+    "        vec4 l = texture2D(tileLayout, \n"
+    "                           vec2((float(i) + 0.5) / boardSize, 0.5));\n"
+    "        vec2 c = vec2(decode(l.r, l.g), decode(l.b, l.a));\n"
+    "\n"
+    "        if ((pixel.x >= c.x) && (pixel.x < c.x + tileSize.x)) {\n"
+    "            tile.x   = float(i);\n"
+    "            corner.x = c.x;\n"
+    "        }\n"
+    "        if ((pixel.y >= c.y) && (pixel.y < c.y + tileSize.y)) {\n"
+    "            tile.y   = float(i);\n"
+    "            corner.y = c.y;\n"
+    "        }\n"
+    "    }\n"
+    "\n"
+    "    if ((tile.x < 0.0) || (tile.y < 0.0)) {\n"
+    "        discard;\n"
+    "    }\n"
+    "\n"
+    "    vec4  data  = texture2D(tiles, (tile + 0.5) / boardSize);\n"
+    "    float face  = floor(data.r * 255.0 + 0.5);\n"
+    "    vec2  local = pixel - corner;\n"
+    "    vec4  color;\n"
+    "\n"
+    "    if (data.g > 0.5) {\n"
+    "        vec2 faceTile = vec2(mod(face, givenColumns),\n"
+    "                             floor(face / givenColumns));\n"
+    "        color = texture2D(givenTilemap, \n"
+    "            (givenOffset + (faceTile * tileSize) + local) / \n"
+    "            givenTextureSize);\n"
+    "    } else {\n"
+    "        vec2 faceTile = vec2(mod(face, userColumns),\n"
+    "                             floor(face / userColumns));\n"
+    "        color = texture2D(userTilemap, \n"
+    "            (userOffset + (faceTile * tileSize) + local) / \n"
+    "            userTextureSize);\n"
+    "    }\n"
+    "\n"
+    "    gl_FragColor = gl_Color * color;\n"
+    "}\n";
+
+//-----------------------------------------------------------------------------
+ShaderBoardView::ShaderBoardView(BoardModelAdapter *board,
+                                 BoardLayout       *layout,
+                                 const std::string &givenTilemapFilename,
+                                 const std::string &userTilemapFilename) :
+    _board(board),
+    _givenTilemap(givenTilemapFilename),
+    _userTilemap(userTilemapFilename),
+    _boardVersion(0),
+    _isLoaded(false)
+{
+    if ((board == NULL) || (layout == NULL) || (!sf::Shader::isAvailable())) {
+        return;
+    }
+
+    unsigned int boardSize = 
+        std::max(_board->columnSize(), _board->rowSize());
+
+    if ((boardSize == 0) || (boardSize > SHADERBOARD_MAX_SIZE) ||
+        (_givenTilemap.get() == NULL) || (_userTilemap.get() == NULL)) {
+        return;
+    }
+
+    _tileSize = layout->tileSize();
+
+    // The layout's transform fits large boards to the screen. The tile
+    // positions below are in the board's space.
+    _transform = layout->screenTransform();
+
+    // The board layout is a grid: the column only moves the tile 
+    // horizontally, and the row only moves it vertically. Store the tile's
+    // top-left corner for each column / row.
+    sf::Vector2f boardTopLeft;
+    sf::Vector2f boardBottomRight;
+
+    for (unsigned int i = 0; i < boardSize; i++) {
+        sf::Vector2f tilePos = layout->tilePositionInScreen(i, i);
+        sf::Vector2f corner(
+            std::floor(tilePos.x - (_tileSize.x / 2) + 0.5f),
+            std::floor(tilePos.y - (_tileSize.y / 2) + 0.5f)
+        );
+
+        _tileCorner.push_back(corner);
+
+        if (i == 0) {
+            boardTopLeft     = corner;
+            boardBottomRight = corner;
+        }
+        boardTopLeft.x     = std::min(boardTopLeft.x,     corner.x);
+        boardTopLeft.y     = std::min(boardTopLeft.y,     corner.y);
+        boardBottomRight.x = std::max(boardBottomRight.x, corner.x);
+        boardBottomRight.y = std::max(boardBottomRight.y, corner.y);
+    }
+
+    boardBottomRight.x += _tileSize.x;
+    boardBottomRight.y += _tileSize.y;
+
+    // The layout texture stores the corners relative to the board's top-left
+    // corner, so a board that's larger than the screen can still be encoded
+    std::vector<sf::Uint8> layoutData(boardSize * 4);
+
+    for (unsigned int i = 0; i < boardSize; i++) {
+        sf::Vector2f corner = _tileCorner[i] - boardTopLeft;
+
+        if ((corner.x > 65535) || (corner.y > 65535)) {
+            // Can't be encoded in the layout texture
+            _tileCorner.clear();
+            return;
+        }
+
+        unsigned int x = (unsigned int) corner.x;
+        unsigned int y = (unsigned int) corner.y;
+        layoutData[(i * 4) + 0] = (sf::Uint8) (x >> 8);
+        layoutData[(i * 4) + 1] = (sf::Uint8) (x & 0xFF);
+        layoutData[(i * 4) + 2] = (sf::Uint8) (y >> 8);
+        layoutData[(i * 4) + 3] = (sf::Uint8) (y & 0xFF);
+    }
+
+    if ((!_layoutTexture.create(boardSize, 1)) ||
+        (!_tileTexture.create(boardSize, boardSize)) ||
+        (!_shader.loadFromMemory(_boardFragmentShader, 
+                                 sf::Shader::Fragment))) {
+        return;
+    }
+
+    _layoutTexture.update(&layoutData[0]);
+
+    // The quad's texture coordinates are its position relative to the board's
+    // top-left corner, so the shader knows which pixel it's drawing
+    _vertex[0].position = boardTopLeft;
+    _vertex[1].position = sf::Vector2f(boardBottomRight.x, boardTopLeft.y);
+    _vertex[2].position = boardBottomRight;
+    _vertex[3].position = sf::Vector2f(boardTopLeft.x, boardBottomRight.y);
+
+    for (unsigned int i = 0; i < 4; i++) {
+        _vertex[i].texCoords = _vertex[i].position - boardTopLeft;
+    }
+
+    sf::Vector2u givenOffset = _givenTilemap.getOffset();
+    sf::Vector2u userOffset  = _userTilemap.getOffset();
+
+    _shader.setParameter("tiles",            _tileTexture);
+    _shader.setParameter("tileLayout",       _layoutTexture);
+    _shader.setParameter("givenTilemap",     *_givenTilemap.get());
+    _shader.setParameter("userTilemap",      *_userTilemap.get());
+    _shader.setParameter("boardSize",        (float) boardSize);
+    _shader.setParameter("tileSize",         sf::Vector2f(_tileSize));
+    _shader.setParameter("givenOffset",      sf::Vector2f(givenOffset));
+    _shader.setParameter("givenTextureSize", 
+                         sf::Vector2f(_givenTilemap.get()->getSize()));
+    _shader.setParameter("givenColumns",     
+                         (float) (_givenTilemap.getSize().x / _tileSize.x));
+    _shader.setParameter("userOffset",       sf::Vector2f(userOffset));
+    _shader.setParameter("userTextureSize",  
+                         sf::Vector2f(_userTilemap.get()->getSize()));
+    _shader.setParameter("userColumns",      
+                         (float) (_userTilemap.getSize().x / _tileSize.x));
+
+    // Force the first update to upload the whole board
+    _tileData = std::vector<sf::Uint8> (boardSize * boardSize * 4, 0xFF);
+    _boardVersion = _board->version() - 1;
+
+    _isLoaded = true;
+}
+
+void ShaderBoardView::update(sf::Time elapsedTime) {
+    if ((!_isLoaded) || (_boardVersion == _board->version())) {
+        // The board hasn't changed since the last update
+        return;
+    }
+
+    unsigned int boardSize = _tileCorner.size();
+
+    for (unsigned int row = 0; row < boardSize; row++) {
+        for (unsigned int col = 0; col < boardSize; col++) {
+            sf::Uint8 face    = 0;
+            sf::Uint8 isGiven = 0;
+
+            if (_board->tileIsInBoard(row, col)) {
+                face    = (sf::Uint8) _board->unmaskedValue(row, col);
+                isGiven = _board->tileIsMasked(row, col) ? 0xFF : 0;
+            } else {
+                // Nothing to draw outside the board
+                face    = BOARDMODEL_MASK_VALUE;
+            }
+
+            sf::Uint8 *data = &_tileData[((row * boardSize) + col) * 4];
+            if ((data[0] == face) && (data[1] == isGiven)) {
+                continue;
+            }
+
+            data[0] = face;
+            data[1] = isGiven;
+            data[2] = 0;
+            data[3] = 0xFF;
+
+            DirtyRegion_add(_transform.transformRect(
+                sf::FloatRect(_tileCorner[col].x, 
+                              _tileCorner[row].y,
+                              (float) _tileSize.x,
+                              (float) _tileSize.y)
+            ));
+        }
+    }
+
+    _boardVersion = _board->version();
+}
+
+void ShaderBoardView::draw(SpriteBatch *batch) {
+    // Don't draw if it's not supposed to be shown
+    if ((!_isShowed) || (!_isLoaded)) {
+        return;
+    }
+
+    // The tile data is uploaded by the thread that draws the frame, so the
+    // frames that are still waiting to be drawn keep their own tile data. 
+    // It's tiny, so it's sent with every frame: a frame may be skipped by 
+    // the render thread.
+    batch->updateTexture(&_tileTexture, &_tileData[0]);
+    batch->drawWithShader(_vertex, 4, NULL, &_shader, _layer, _transform);
+}
@@ -21,13 +21,16 @@
  * IN THE SOFTWARE.
  */
 
+#include <algorithm>
+#include "assetloader.h"
 #include "gamemanager.h"
+#include "menustate.h"
 #include "splashscreenstate.h"
 
 #define SPLASHSCREEN_DURATION_IN_SEC    2
 
 SplashScreenState::SplashScreenState() {
-    _texture.loadFromFile("artwork/sudoku-splashscreen.png");
+    _texture = SharedTexture("artwork/sudoku-splashscreen.png");
 }
 
 SplashScreenState::~SplashScreenState() {
@@ -36,13 +39,29 @@ SplashScreenState::~SplashScreenState() {
 void SplashScreenState::update(sf::Time elapsedTime) {
     _runningTime = _runningTime + elapsedTime;
 
-    if (_runningTime.asSeconds() > SPLASHSCREEN_DURATION_IN_SEC) {
-        // Exit this game state
+    if ((_runningTime.asSeconds() > SPLASHSCREEN_DURATION_IN_SEC) &&
+        (AssetLoader_isFinished())) {
+        // Exit this game state, and start the game with the artwork that has
+        // been loaded
         GameManager_popGameState();
+        GameManager_pushGameState(new MenuState());
     }
 }
 
-void SplashScreenState::draw(sf::RenderWindow *win) {
-    sf::Sprite background(_texture);
-    win->draw(background);
+sf::Time SplashScreenState::timeToNextUpdate() {
+    if (!AssetLoader_isFinished()) {
+        // The artwork is uploaded a few images per frame
+        return sf::Time::Zero;
+    }
+
+    // Nothing is animated, only wake up to leave this game state
+    sf::Time remainingTime = 
+        sf::seconds(SPLASHSCREEN_DURATION_IN_SEC) - _runningTime;
+
+    return std::max(remainingTime, sf::Time::Zero);
+}
+
+void SplashScreenState::draw(SpriteBatch *batch) {
+    sf::Sprite background(*_texture.get(), _texture.getRegion());
+    batch->draw(background, SPRITE_LAYER_BACKGROUND);
 }
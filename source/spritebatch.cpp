@@ -0,0 +1,193 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include "spritebatch.h"
+#include "targetrenderbackend.h"
+
+SpriteBatch::SpriteBatch() :
+    _submissions(0)
+{
+    _stats.submissions     = 0;
+    _stats.drawCalls       = 0;
+    _stats.vertices        = 0;
+    _stats.textureSwitches = 0;
+}
+
+void SpriteBatch::draw(const sf::Vertex    *vertex, 
+                       unsigned int         vertexCount,
+                       const sf::Texture   *texture,
+                       int                  layer,
+                       const sf::Transform &transform) {
+    drawWithShader(vertex, vertexCount, texture, NULL, layer, transform);
+}
+
+void SpriteBatch::drawWithShader(const sf::Vertex    *vertex, 
+                                 unsigned int         vertexCount,
+                                 const sf::Texture   *texture,
+                                 const sf::Shader    *shader,
+                                 int                  layer,
+                                 const sf::Transform &transform) {
+    _submissions++;
+
+    if ((vertex == NULL) || (vertexCount == 0)) {
+        return;
+    }
+
+    SpriteBatchItem item;
+    item.layer       = layer;
+    item.texture     = texture;
+    item.shader      = shader;
+    item.transform   = transform;
+    item.firstVertex = _vertex.size();
+    item.vertexCount = vertexCount;
+
+    _items.push_back(item);
+    _vertex.insert(_vertex.end(), vertex, vertex + vertexCount);
+}
+
+void SpriteBatch::draw(const sf::Sprite &sprite, int layer) {
+    sf::FloatRect   bounds    = sprite.getLocalBounds();
+    sf::IntRect     texRect   = sprite.getTextureRect();
+    sf::Transform   transform = sprite.getTransform();
+    sf::Color       color     = sprite.getColor();
+
+    float left   = (float) texRect.left;
+    float top    = (float) texRect.top;
+    float right  = (float) (texRect.left + texRect.width);
+    float bottom = (float) (texRect.top  + texRect.height);
+
+    sf::Vertex quad[4] = {
+        sf::Vertex(transform.transformPoint(0, 0),
+                   color, sf::Vector2f( left,    top)),
+        sf::Vertex(transform.transformPoint(bounds.width, 0),
+                   color, sf::Vector2f(right,    top)),
+        sf::Vertex(transform.transformPoint(bounds.width, bounds.height),
+                   color, sf::Vector2f(right, bottom)),
+        sf::Vertex(transform.transformPoint(0, bounds.height),
+                   color, sf::Vector2f( left, bottom))
+    };
+
+    draw(quad, 4, sprite.getTexture(), layer);
+}
+
+void SpriteBatch::updateTexture(sf::Texture     *texture, 
+                                const sf::Uint8 *pixels) {
+    if ((texture == NULL) || (pixels == NULL)) {
+        return;
+    }
+
+    sf::Vector2u size = texture->getSize();
+
+    SpriteBatchTextureUpdate update;
+    update.texture    = texture;
+    update.firstPixel = _pixels.size();
+
+    _textureUpdates.push_back(update);
+    _pixels.insert(_pixels.end(), pixels, pixels + (size.x * size.y * 4));
+}
+
+void SpriteBatch::flush(sf::RenderTarget *target) {
+    TargetRenderBackend backend(target);
+    flush(&backend);
+}
+
+void SpriteBatch::flush(AbstractRenderBackend *backend) {
+    _stats.submissions     = _submissions;
+    _stats.drawCalls       = 0;
+    _stats.vertices        = _vertex.size();
+    _stats.textureSwitches = 0;
+
+    // The textures have to be updated before the quads that use them
+    for (unsigned int i = 0; i < _textureUpdates.size(); i++) {
+        backend->updateTexture(_textureUpdates[i].texture, 
+                               &_pixels[_textureUpdates[i].firstPixel]);
+    }
+
+    // Keep the submission order for the quads in the same layer, they may 
+    // overlap each other. Only the adjacent items with the same texture are
+    // merged into a draw call.
+    std::stable_sort(_items.begin(), _items.end(), isDrawnBefore);
+
+    _sortedVertex.resize(_vertex.size());
+
+    unsigned int runStart = 0;
+    unsigned int runEnd   = 0;
+    const sf::Texture *lastTexture = NULL;
+
+    for (unsigned int i = 0; i < _items.size(); i++) {
+        const SpriteBatchItem *item = &_items[i];
+
+        std::copy(_vertex.begin() + item->firstVertex,
+                  _vertex.begin() + item->firstVertex + item->vertexCount,
+                  _sortedVertex.begin() + runEnd);
+        runEnd += item->vertexCount;
+
+        // Draw the run when the next item needs another texture / shader /
+        // transform. The items are already in the drawing order, so the run
+        // may span several layers.
+        bool isLastInRun = 
+            (i + 1 == _items.size())                 || 
+            (_items[i + 1].texture != item->texture) ||
+            (_items[i + 1].shader  != item->shader)  ||
+            (!isSameTransform(_items[i + 1].transform, item->transform));
+
+        if (!isLastInRun) {
+            continue;
+        }
+
+        if ((_stats.drawCalls == 0) || (item->texture != lastTexture)) {
+            _stats.textureSwitches++;
+        }
+        lastTexture = item->texture;
+
+        backend->drawQuads(&_sortedVertex[runStart], 
+                           runEnd - runStart, 
+                           item->texture,
+                           item->shader,
+                           item->transform);
+
+        _stats.drawCalls++;
+        runStart = runEnd;
+    }
+
+    clear();
+}
+
+void SpriteBatch::clear() {
+    _vertex.clear();
+    _items.clear();
+    _textureUpdates.clear();
+    _pixels.clear();
+    _submissions = 0;
+}
+
+bool SpriteBatch::isSameTransform(const sf::Transform &a, 
+                                  const sf::Transform &b) {
+    return std::equal(a.getMatrix(), a.getMatrix() + 16, b.getMatrix());
+}
+
+bool SpriteBatch::isDrawnBefore(const SpriteBatchItem &a, 
+                                const SpriteBatchItem &b) {
+    return a.layer < b.layer;
+}
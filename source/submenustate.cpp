@@ -22,6 +22,7 @@
  */
 
 #include "gamemanager.h"
+#include "gamestatepool.h"
 #include "submenustate.h"
 #include "play9x9sudokustate.h"
 
@@ -41,11 +42,24 @@
 ///
 #define MENU_SCREENSIZE     sf::Vector2f(480, 320)
 
+///
+/// \brief The game state's pool name (see gamestatepool.h)
+///
+#define SUBMENU_POOL_NAME   "SubMenuState"
+
+//-----------------------------------------------------------------------------
+///
+/// \brief Create the play state, for the game state builder
+///
+static AbstractGameState *SubMenuState_createPlayState() {
+    return Play9x9SudokuState::create();
+}
+
 //-----------------------------------------------------------------------------
 SubMenuState::SubMenuState() : 
     _currentSubMenu(SUBMENU_START) 
 {
-    _backgroundTexture.loadFromFile("artwork/sudoku-menu-background.png");
+    _backgroundTexture = SharedTexture("artwork/sudoku-menu-background.png");
 
         // Set menu item model
     for (unsigned int i = static_cast<int>(SUBMENU_START); 
@@ -66,11 +80,41 @@ SubMenuState::SubMenuState() :
                   "artwork/sudoku-submenu.png"
         );
     _submenuView.show();
+
+    reset();
 }
 
 SubMenuState::~SubMenuState() {
 }
 
+SubMenuState *SubMenuState::create() {
+    SubMenuState *state = static_cast<SubMenuState *>(
+        GameStatePool_acquire(SUBMENU_POOL_NAME));
+
+    if (state == NULL) {
+        return new SubMenuState();
+    }
+
+    state->reset();
+
+    return state;
+}
+
+void SubMenuState::reset() {
+    _currentSubMenu = SUBMENU_START;
+
+    // Every difficulty starts the same play state. Build it while the player
+    // is choosing, so it's ready when the difficulty is selected.
+    std::vector<std::string> textures;
+    Play9x9SudokuState::textureFilenames(&textures);
+
+    _playStateBuilder.start(&SubMenuState_createPlayState, textures);
+}
+
+const char *SubMenuState::poolName() const {
+    return SUBMENU_POOL_NAME;
+}
+
 void SubMenuState::processKeypressEvent(enum _keys key) {
     int position = static_cast<int> (_currentSubMenu);
 
@@ -100,7 +144,7 @@ void SubMenuState::processKeypressEvent(enum _keys key) {
     }
 
     case KEY_SELECT: {
-        GameManager_pushGameState(new Play9x9SudokuState());
+        GameManager_pushGameState(_playStateBuilder.take());
         break;
     }
     }
@@ -115,18 +159,19 @@ void SubMenuState::update(sf::Time elapsedTime) {
         // Each menu item in this tilemap has 2 entry. One for normal, and the
         // other for the highlighted
         if (i != static_cast<int> (_currentSubMenu)) {
-            _submenuModel[i] = (i * 2);
+            _submenuModelAdapter.setValue((i * 2), i, 0);
         } else {
-            _submenuModel[i] = (i * 2) + 1;
+            _submenuModelAdapter.setValue((i * 2) + 1, i, 0);
         }
     }
 
     _submenuView.update(elapsedTime);
 }
 
-void SubMenuState::draw(sf::RenderWindow *win) {
-    sf::Sprite background(_backgroundTexture);
-    win->draw(background);
+void SubMenuState::draw(SpriteBatch *batch) {
+    sf::Sprite background(*_backgroundTexture.get(), 
+                          _backgroundTexture.getRegion());
+    batch->draw(background, SPRITE_LAYER_BACKGROUND);
 
-    _submenuView.draw(win);
+    _submenuView.draw(batch);
 }
@@ -21,14 +21,9 @@
  * IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include "sudokuboardlayout.h"
 
-// Define sub-board column size (because the board is only defining the total 
-// column size)
-#define SUBBOARD_COLUMN_SIZE_2  4
-#define SUBBOARD_COLUMN_SIZE_3  9
-#define SUBBOARD_COLUMN_SIZE_4  16
-
 SudokuBoardLayout::SudokuBoardLayout(BoardModelAdapter *board, 
                                      sf::Vector2u       tileSize,
                                      sf::Vector2f       screenSize, 
@@ -47,9 +42,10 @@ sf::Vector2f SudokuBoardLayout::tilePositionInScreen(int row, int column) {
     // distance between sub-board is (1/2 * tileSize).
     //
     // Based on this measurement, the center for :
-    // 4x4 board = (2.75 tileSize, 2.75 tileSize)
-    // 9x9 board = (6    tileSize, 6    tileSize)
-    //16x16board = (10.5 tileSize, 10.5 tileSize)
+    // 4x4 board = (2.75  tileSize, 2.75  tileSize)
+    // 9x9 board = (6     tileSize, 6     tileSize)
+    //16x16board = (10.5  tileSize, 10.5  tileSize)
+    //25x25board = (16.25 tileSize, 16.25 tileSize)
     //
     // Using these formulas:
     //     screenColCenter = n.tileSize + colOffset 
@@ -61,31 +57,67 @@ sf::Vector2f SudokuBoardLayout::tilePositionInScreen(int row, int column) {
     
     float colOffset = _screenOffset.x + screenColCenter;
     float rowOffset = _screenOffset.y + screenRowCenter;
-    
-    int subboardSize;
-    switch (_board->columnSize()) {
-    case SUBBOARD_COLUMN_SIZE_2:
-        colOffset -= (2.75f * _tileSize.x);
-        rowOffset -= (2.75f * _tileSize.y);
-        subboardSize = 2;
-        break;
-    case SUBBOARD_COLUMN_SIZE_3:
-        colOffset -= (  6.f * _tileSize.x);
-        rowOffset -= (  6.f * _tileSize.y);
-        subboardSize = 3;
-        break;
-    case SUBBOARD_COLUMN_SIZE_4:
-        colOffset -= (10.5f * _tileSize.x);
-        rowOffset -= (10.5f * _tileSize.y);
-        subboardSize = 4;
-        break;
-    }
 
-    float x = 0.75f + (1.25f * column) + (0.25f * (column / subboardSize));
-    float y = 0.75f + (1.25f * row)    + (0.25f * (row    / subboardSize));
+    colOffset -= (boardCenter() * _tileSize.x);
+    rowOffset -= (boardCenter() * _tileSize.y);
+
+    int subboard = subboardSize();
+
+    float x = 0.75f + (1.25f * column) + (0.25f * (column / subboard));
+    float y = 0.75f + (1.25f * row)    + (0.25f * (row    / subboard));
 
     x = (x * _tileSize.x) + colOffset;
     y = (y * _tileSize.y) + rowOffset;
 
     return sf::Vector2f(x, y);
 }
+
+sf::Transform SudokuBoardLayout::screenTransform() {
+    sf::Transform transform;
+
+    // The board's width / height, including the margin around it
+    float boardWidth  = 2 * boardCenter() * _tileSize.x;
+    float boardHeight = 2 * boardCenter() * _tileSize.y;
+
+    if ((boardWidth <= _screenSize.x) && (boardHeight <= _screenSize.y)) {
+        // The board fits into the drawable screen
+        return transform;
+    }
+
+    float scale = std::min(_screenSize.x / boardWidth, 
+                           _screenSize.y / boardHeight);
+
+    transform.scale(scale, scale, 
+                    _screenOffset.x + (_screenSize.x / 2),
+                    _screenOffset.y + (_screenSize.y / 2));
+
+    return transform;
+}
+
+int SudokuBoardLayout::subboardSize() {
+    int boardSize    = (int) _board->columnSize();
+    int subboardSize = 1;
+
+    while (((subboardSize + 1) * (subboardSize + 1)) <= boardSize) {
+        subboardSize++;
+    }
+
+    if ((subboardSize * subboardSize) != boardSize) {
+        // Not a sudoku board, draw it as a single sub-board
+        subboardSize = boardSize;
+    }
+
+    return (subboardSize > 0) ? subboardSize : 1;
+}
+
+float SudokuBoardLayout::boardCenter() {
+    // Half of the distance between the first and the last tile's center,
+    // plus the margin before the first tile's center
+    int boardSize = (int) _board->columnSize();
+    int subboard  = subboardSize();
+
+    float boardSpan = (1.25f * (boardSize - 1)) + 
+                      (0.25f * ((boardSize - 1) / subboard));
+
+    return 0.75f + (boardSpan / 2);
+}
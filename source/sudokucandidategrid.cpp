@@ -0,0 +1,307 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "sudokucandidategrid.h"
+
+//-----------------------------------------------------------------------------
+SudokuCandidateGrid::SudokuCandidateGrid(std::vector<unsigned int> *board,
+                                         unsigned int          boardSize) :
+    _sudokuBoard(board),
+    _boardSize(boardSize),
+    _subboardSize(0),
+    _allDigits(0),
+    _peerCount(0),
+    _version(0)
+{
+    if (board == NULL) {
+        return;
+    }
+
+    // The sub-board size is the square root of the board size (3 for 9x9)
+    while (((_subboardSize + 1) * (_subboardSize + 1)) <= _boardSize) {
+        _subboardSize++;
+    }
+
+    // Bit #0 is not used, since digit 0 means empty tile
+    _allDigits = ((1u << (_boardSize + 1)) - 1) & ~1u;
+
+    unsigned int tileCount = _boardSize * _boardSize;
+
+    _tileDigit  = std::vector<unsigned int> (tileCount, 0);
+    _candidates = std::vector<unsigned int> (tileCount, 0);
+
+    _rowDigits      = std::vector<unsigned int> (_boardSize, 0);
+    _columnDigits   = std::vector<unsigned int> (_boardSize, 0);
+    _subboardDigits = std::vector<unsigned int> (_boardSize, 0);
+
+    _rowCount      = std::vector<unsigned int> (_boardSize * (_boardSize + 1), 0);
+    _columnCount   = std::vector<unsigned int> (_boardSize * (_boardSize + 1), 0);
+    _subboardCount = std::vector<unsigned int> (_boardSize * (_boardSize + 1), 0);
+
+    _tileCandidateCount  = std::vector<int> (tileCount, -1);
+    _emptyTiles          = Bitboard(tileCount);
+    _candidateCountTiles = std::vector<Bitboard> (_boardSize + 1, 
+                                                  Bitboard(tileCount));
+    _digitTiles          = std::vector<Bitboard> (_boardSize + 1, 
+                                                  Bitboard(tileCount));
+    _conflictTiles       = Bitboard(tileCount);
+
+    for (unsigned int tile = 0; tile < tileCount; tile++) {
+        unsigned int row    = tile / _boardSize;
+        unsigned int column = tile % _boardSize;
+
+        _tileRow.push_back(row);
+        _tileColumn.push_back(column);
+        _tileSubboard.push_back(
+            ((row / _subboardSize) * _subboardSize) + (column / _subboardSize)
+        );
+    }
+
+    // Each tile sees the other tiles in its row and column, plus the tiles in
+    // its sub-board that are not in the same row or column
+    _peerCount = (2 * (_boardSize - 1)) + 
+                 ((_subboardSize - 1) * (_subboardSize - 1));
+
+    for (unsigned int tile = 0; tile < tileCount; tile++) {
+        for (unsigned int peer = 0; peer < tileCount; peer++) {
+            if (peer == tile) {
+                continue;
+            }
+
+            if ((_tileRow[peer]      == _tileRow[tile])    ||
+                (_tileColumn[peer]   == _tileColumn[tile]) ||
+                (_tileSubboard[peer] == _tileSubboard[tile])) {
+                _peers.push_back(peer);
+            }
+        }
+    }
+
+    rebuild();
+}
+
+void SudokuCandidateGrid::rebuild() {
+    for (unsigned int i = 0; i < _boardSize; i++) {
+        _rowDigits[i]      = 0;
+        _columnDigits[i]   = 0;
+        _subboardDigits[i] = 0;
+    }
+
+    for (unsigned int i = 0; i < _rowCount.size(); i++) {
+        _rowCount[i]      = 0;
+        _columnCount[i]   = 0;
+        _subboardCount[i] = 0;
+    }
+
+    for (unsigned int tile = 0; tile < _tileDigit.size(); tile++) {
+        unsigned int digit = (*_sudokuBoard)[tile];
+
+        _tileDigit[tile] = digit;
+
+        if (digit > 0) {
+            addDigit(tile, digit);
+        }
+    }
+
+    for (unsigned int tile = 0; tile < _tileDigit.size(); tile++) {
+        updateCandidate(tile);
+        updateConflict(tile);
+    }
+
+    _version++;
+}
+
+void SudokuCandidateGrid::setDigit(unsigned int digit, int row, int column) {
+    unsigned int tile     = (row * _boardSize) + column;
+    unsigned int oldDigit = _tileDigit[tile];
+
+    if (oldDigit == digit) {
+        // Nothing has changed
+        return;
+    }
+
+    if (oldDigit > 0) {
+        removeDigit(tile, oldDigit);
+    }
+
+    if (digit > 0) {
+        addDigit(tile, digit);
+    }
+
+    _tileDigit[tile] = digit;
+
+    // Only the tile itself and its peers are affected by the change
+    updateCandidate(tile);
+    updateConflict(tile);
+
+    for (unsigned int i = 0; i < _peerCount; i++) {
+        unsigned int peer = _peers[(tile * _peerCount) + i];
+
+        updateCandidate(peer);
+
+        if ((_tileDigit[peer] == oldDigit) || (_tileDigit[peer] == digit)) {
+            updateConflict(peer);
+        }
+    }
+
+    _version++;
+}
+
+void SudokuCandidateGrid::updateCandidate(unsigned int tile) {
+    unsigned int candidates = 0;
+
+    if (_tileDigit[tile] == 0) {
+        candidates = _allDigits & ~(_rowDigits     [_tileRow[tile]]    | 
+                                    _columnDigits  [_tileColumn[tile]] |
+                                    _subboardDigits[_tileSubboard[tile]]);
+        _emptyTiles.set(tile);
+    } else {
+        // The tile is filled, no candidate is needed
+        _emptyTiles.reset(tile);
+    }
+
+    // Update the digit indexes, only for the candidates that have changed
+    unsigned int changed = candidates ^ _candidates[tile];
+    while (changed != 0) {
+        unsigned int digit = Bitboard::lowestBit(changed);
+        changed &= (changed - 1);
+
+        if ((candidates & (1u << digit)) != 0) {
+            _digitTiles[digit].set(tile);
+        } else {
+            _digitTiles[digit].reset(tile);
+        }
+    }
+
+    _candidates[tile] = candidates;
+
+    // Move the tile into its candidate count group
+    int count = -1;
+    if (_tileDigit[tile] == 0) {
+        count = (int) Bitboard::bitCount(candidates);
+    }
+
+    if (count != _tileCandidateCount[tile]) {
+        if (_tileCandidateCount[tile] >= 0) {
+            _candidateCountTiles[_tileCandidateCount[tile]].reset(tile);
+        }
+
+        if (count >= 0) {
+            _candidateCountTiles[count].set(tile);
+        }
+
+        _tileCandidateCount[tile] = count;
+    }
+}
+
+unsigned int SudokuCandidateGrid::availableDigitMask(int row, 
+                                                     int column) const {
+    unsigned int tile  = (row * _boardSize) + column;
+    unsigned int digit = _tileDigit[tile];
+
+    if (digit == 0) {
+        return _candidates[tile];
+    }
+
+    unsigned int rowNo      = (_tileRow[tile]      * (_boardSize + 1)) + digit;
+    unsigned int columnNo   = (_tileColumn[tile]   * (_boardSize + 1)) + digit;
+    unsigned int subboardNo = (_tileSubboard[tile] * (_boardSize + 1)) + digit;
+
+    unsigned int usedDigits = _rowDigits     [_tileRow[tile]]    | 
+                              _columnDigits  [_tileColumn[tile]] |
+                              _subboardDigits[_tileSubboard[tile]];
+
+    // The tile's own digit is still available, if no peer is using it
+    if ((_rowCount[rowNo]           == 1) && 
+        (_columnCount[columnNo]     == 1) &&
+        (_subboardCount[subboardNo] == 1)) {
+        usedDigits &= ~(1u << digit);
+    }
+
+    return _allDigits & ~usedDigits;
+}
+
+int SudokuCandidateGrid::nextEmptyTile(int row, int column) const {
+    return _emptyTiles.findNext((row * _boardSize) + column + 1);
+}
+
+int SudokuCandidateGrid::nextFewestCandidateTile(int row, int column) const {
+    // Find the smallest group that's not empty
+    for (unsigned int count = 1; count <= _boardSize; count++) {
+        if (_candidateCountTiles[count].count() > 0) {
+            return _candidateCountTiles[count].findNext(
+                (row * _boardSize) + column + 1
+            );
+        }
+    }
+
+    return -1;
+}
+
+int SudokuCandidateGrid::nextTileAccepting(unsigned int digit, 
+                                           int          row, 
+                                           int          column) const {
+    if ((digit == 0) || (digit > _boardSize)) {
+        return -1;
+    }
+
+    return _digitTiles[digit].findNext((row * _boardSize) + column + 1);
+}
+
+void SudokuCandidateGrid::updateConflict(unsigned int tile) {
+    unsigned int digit = _tileDigit[tile];
+
+    if ((digit > 0) && 
+        ((_rowCount     [(_tileRow[tile]      * (_boardSize + 1)) + digit] > 1) ||
+         (_columnCount  [(_tileColumn[tile]   * (_boardSize + 1)) + digit] > 1) ||
+         (_subboardCount[(_tileSubboard[tile] * (_boardSize + 1)) + digit] > 1))) {
+        _conflictTiles.set(tile);
+    } else {
+        _conflictTiles.reset(tile);
+    }
+}
+
+void SudokuCandidateGrid::addDigit(unsigned int tile, unsigned int digit) {
+    _rowCount     [(_tileRow[tile]      * (_boardSize + 1)) + digit]++;
+    _columnCount  [(_tileColumn[tile]   * (_boardSize + 1)) + digit]++;
+    _subboardCount[(_tileSubboard[tile] * (_boardSize + 1)) + digit]++;
+
+    _rowDigits     [_tileRow[tile]]      |= (1u << digit);
+    _columnDigits  [_tileColumn[tile]]   |= (1u << digit);
+    _subboardDigits[_tileSubboard[tile]] |= (1u << digit);
+}
+
+void SudokuCandidateGrid::removeDigit(unsigned int tile, unsigned int digit) {
+    // The digit is only free again in the unit once its last occurrence is 
+    // removed
+    if (--_rowCount[(_tileRow[tile] * (_boardSize + 1)) + digit] == 0) {
+        _rowDigits[_tileRow[tile]] &= ~(1u << digit);
+    }
+
+    if (--_columnCount[(_tileColumn[tile] * (_boardSize + 1)) + digit] == 0) {
+        _columnDigits[_tileColumn[tile]] &= ~(1u << digit);
+    }
+
+    if (--_subboardCount[(_tileSubboard[tile] * (_boardSize + 1)) + digit] == 0) {
+        _subboardDigits[_tileSubboard[tile]] &= ~(1u << digit);
+    }
+}
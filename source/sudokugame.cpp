@@ -28,7 +28,8 @@
 
 //-----------------------------------------------------------------------------
 SudokuGame::SudokuGame(std::vector<unsigned int> *board) :
-    _sudokuBoard(board) 
+    _sudokuBoard(board),
+    _candidateGrid(board, SUDOKU_TYPE_9X9)
 {
 }
 
@@ -53,9 +54,10 @@ bool SudokuGame::isDigitValid(unsigned int digit, int row, int column) {
 
 std::vector<unsigned int> SudokuGame::availableDigit(int row, int column) {
     std::vector<unsigned int> availableDigit;
+    unsigned int              digitMask = availableDigitMask(row, column);
 
     for (unsigned int i = 1; i <= 9; i++) {
-        if (isDigitValid(i, row, column)) {
+        if ((digitMask & (1u << i)) != 0) {
             availableDigit.push_back(i);
         }
     }
@@ -63,7 +65,16 @@ std::vector<unsigned int> SudokuGame::availableDigit(int row, int column) {
     return availableDigit;
 }
 
+unsigned int SudokuGame::availableDigitMask(int row, int column) const {
+    return _candidateGrid.availableDigitMask(row, column);
+}
+
 bool SudokuGame::isGameOver() {
+    // A full board with conflicting digits is not solved yet
+    if (_candidateGrid.conflictCount() > 0) {
+        return false;
+    }
+
     for (std::vector<unsigned int>::iterator it = _sudokuBoard->begin(); 
                                              it < _sudokuBoard->end(); 
                                              it++) 
@@ -76,6 +87,22 @@ bool SudokuGame::isGameOver() {
     return true;
 }
 
+void SudokuGame::updateTile(int row, int column) {
+    _candidateGrid.setDigit(
+        (*_sudokuBoard)[row * static_cast<int> (SUDOKU_TYPE_9X9) + column],
+        row,
+        column
+    );
+}
+
+void SudokuGame::reset() {
+    _candidateGrid.rebuild();
+}
+
+const SudokuCandidateGrid *SudokuGame::candidateGrid() const {
+    return &_candidateGrid;
+}
+
 bool SudokuGame::isRowValid(int row, int column) {
     // The available digits
     bool validDigits[] = {
@@ -21,6 +21,7 @@
  * IN THE SOFTWARE.
  */
 
+#include <algorithm>
 #include "sudokuscore.h"
 
 //-----------------------------------------------------------------------------
@@ -113,16 +114,39 @@ void SudokuScore::updateScore(int row, int col) {
 
         // Convert the total score into display digit
         scoreToDigit(&_scoreDigitModel, totalScore());
+        _scoreDigitModelAdapter.markChanged();
     }
 }
 
+void SudokuScore::reset() {
+    _currentScore = MAXIMUM_SCORE_PER_TILE;
+    _runningTime  = sf::seconds(0.f);
+
+    std::fill(_scoreModel.begin(),      _scoreModel.end(),      0);
+    std::fill(_scoreDigitModel.begin(), _scoreDigitModel.end(), 0);
+
+    _scoreModelAdapter.markChanged();
+    _scoreDigitModelAdapter.markChanged();
+}
+
 void SudokuScore::update(sf::Time elapsedTime) {
     countdownScore(elapsedTime);
     _scoreDigitView.update(elapsedTime);
 }
 
-void SudokuScore::draw(sf::RenderWindow *win) {
-    _scoreDigitView.draw(win);
+void SudokuScore::draw(SpriteBatch *batch) {
+    _scoreDigitView.draw(batch);
+}
+
+sf::Time SudokuScore::timeToNextUpdate() {
+    if (_runningTime >= MAXIMUM_TIME_PER_TILE) {
+        // The score has counted down to 0
+        return VIEWER_NO_PENDING_UPDATE;
+    }
+
+    // The countdown is computed from the elapsed time, so it only needs to 
+    // be woken up when it reaches 0
+    return MAXIMUM_TIME_PER_TILE - _runningTime;
 }
 
 unsigned int SudokuScore::totalScore() {
@@ -0,0 +1,52 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include "targetrenderbackend.h"
+
+TargetRenderBackend::TargetRenderBackend(sf::RenderTarget *target) :
+    _target(target)
+{
+}
+
+void TargetRenderBackend::drawQuads(const sf::Vertex    *vertex, 
+                                    unsigned int         vertexCount,
+                                    const sf::Texture   *texture,
+                                    const sf::Shader    *shader,
+                                    const sf::Transform &transform) {
+    if (_target == NULL) {
+        return;
+    }
+
+    sf::RenderStates states(texture);
+    states.shader    = shader;
+    states.transform = transform;
+
+    _target->draw(vertex, vertexCount, sf::Quads, states);
+}
+
+void TargetRenderBackend::updateTexture(sf::Texture     *texture, 
+                                        const sf::Uint8 *pixels) {
+    // The texture is updated in the thread (and OpenGL context) that's 
+    // drawing, so the next draw commands see the new pixels
+    texture->update(pixels);
+}
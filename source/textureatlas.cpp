@@ -0,0 +1,227 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <map>
+#include <algorithm>
+#include "textureatlas.h"
+#include "embeddedartwork.h"
+
+//-----------------------------------------------------------------------------
+///
+/// \brief The preferred atlas width. The atlas is made narrower if the 
+///        graphic card can't handle it.
+///
+#define TEXTUREATLAS_WIDTH          2048
+
+///
+/// \brief Empty pixels between the images, so an image never picks up its 
+///        neighbour's pixel
+///
+#define TEXTUREATLAS_PADDING        1
+
+//-----------------------------------------------------------------------------
+///
+/// \brief The image to be packed into the atlas
+///
+struct TextureAtlasImage {
+    std::string  filename;
+    sf::Vector2u size;
+    sf::IntRect  region;
+};
+
+///
+/// \brief The atlas texture
+///
+static sf::Texture *_atlasTexture = NULL;
+
+///
+/// \brief The image regions in the atlas texture, indexed by file name
+///
+static std::map<std::string, sf::IntRect> _atlasRegions;
+
+///
+/// \brief The image regions that are waiting for their image to be uploaded
+///
+static std::map<std::string, sf::IntRect> _packedRegions;
+
+//-----------------------------------------------------------------------------
+///
+/// \brief Sort the images from the tallest to the shortest
+///
+static bool TextureAtlas_isTaller(const TextureAtlasImage *a, 
+                                  const TextureAtlasImage *b) {
+    return a->size.y > b->size.y;
+}
+
+//-----------------------------------------------------------------------------
+bool TextureAtlas_build(const std::vector<std::string> &filenames) {
+    // Load all of the images
+    std::vector<sf::Image>    images(filenames.size());
+    std::vector<std::string>  loadedFilenames;
+    std::vector<sf::Vector2u> loadedSizes;
+    std::vector<sf::Image *>  loadedImages;
+
+    for (unsigned int i = 0; i < filenames.size(); i++) {
+        if (EmbeddedArtwork_loadImage(filenames[i], &images[i])) {
+            loadedFilenames.push_back(filenames[i]);
+            loadedSizes.push_back(images[i].getSize());
+            loadedImages.push_back(&images[i]);
+        }
+    }
+
+    if (!TextureAtlas_pack(loadedFilenames, loadedSizes)) {
+        return false;
+    }
+
+    for (unsigned int i = 0; i < loadedImages.size(); i++) {
+        TextureAtlas_upload(loadedFilenames[i], *loadedImages[i]);
+    }
+
+    return true;
+}
+
+bool TextureAtlas_pack(const std::vector<std::string>  &filenames,
+                       const std::vector<sf::Vector2u> &sizes) {
+    TextureAtlas_destroy();
+
+    unsigned int atlasWidth = 
+        std::min((unsigned int) TEXTUREATLAS_WIDTH, 
+                 sf::Texture::getMaximumSize());
+
+    std::vector<TextureAtlasImage> images(filenames.size());
+    std::vector<TextureAtlasImage *> packedImages;
+
+    for (unsigned int i = 0; (i < filenames.size()) && (i < sizes.size()); 
+         i++) {
+        images[i].filename = filenames[i];
+        images[i].size     = sizes[i];
+
+        if ((sizes[i].x > 0) && (sizes[i].x <= atlasWidth)) {
+            packedImages.push_back(&images[i]);
+        }
+    }
+
+    if (packedImages.empty()) {
+        return false;
+    }
+
+    std::stable_sort(packedImages.begin(), packedImages.end(), 
+                     TextureAtlas_isTaller);
+
+    // Place the images in shelves, from left to right
+    unsigned int shelfTop    = 0;
+    unsigned int shelfHeight = 0;
+    unsigned int shelfLeft   = 0;
+
+    for (unsigned int i = 0; i < packedImages.size(); i++) {
+        sf::Vector2u size = packedImages[i]->size;
+
+        if (shelfLeft + size.x > atlasWidth) {
+            // Start a new shelf below the current one
+            shelfTop    = shelfTop + shelfHeight + TEXTUREATLAS_PADDING;
+            shelfHeight = 0;
+            shelfLeft   = 0;
+        }
+
+        if (shelfHeight == 0) {
+            // The first image is the tallest in the shelf
+            shelfHeight = size.y;
+        }
+
+        packedImages[i]->region = 
+            sf::IntRect(shelfLeft, shelfTop, size.x, size.y);
+
+        shelfLeft = shelfLeft + size.x + TEXTUREATLAS_PADDING;
+    }
+
+    unsigned int atlasHeight = shelfTop + shelfHeight;
+
+    if (atlasHeight > sf::Texture::getMaximumSize()) {
+        // The graphic card can't handle it, use separate textures instead
+        return false;
+    }
+
+    // The images are copied into the atlas when they're uploaded. Start 
+    // with a transparent atlas, so the padding is always empty.
+    sf::Image atlasImage;
+    atlasImage.create(atlasWidth, atlasHeight, sf::Color::Transparent);
+
+    _atlasTexture = new sf::Texture();
+
+    if (!_atlasTexture->loadFromImage(atlasImage)) {
+        TextureAtlas_destroy();
+        return false;
+    }
+
+    for (unsigned int i = 0; i < packedImages.size(); i++) {
+        _packedRegions[packedImages[i]->filename] = packedImages[i]->region;
+    }
+
+    return true;
+}
+
+bool TextureAtlas_upload(const std::string &filename, 
+                         const sf::Image   &image) {
+    std::map<std::string, sf::IntRect>::iterator it = 
+        _packedRegions.find(filename);
+
+    if ((_atlasTexture == NULL) || (it == _packedRegions.end()) ||
+        (image.getSize() != sf::Vector2u(it->second.width, 
+                                         it->second.height))) {
+        return false;
+    }
+
+    _atlasTexture->update(image, it->second.left, it->second.top);
+
+    // The image can be used from now on
+    _atlasRegions[filename] = it->second;
+    _packedRegions.erase(it);
+
+    return true;
+}
+
+const sf::Texture *TextureAtlas_find(const std::string &filename,
+                                     sf::IntRect       *region) {
+    std::map<std::string, sf::IntRect>::const_iterator it = 
+        _atlasRegions.find(filename);
+
+    if ((_atlasTexture == NULL) || (it == _atlasRegions.end())) {
+        return NULL;
+    }
+
+    *region = it->second;
+
+    return _atlasTexture;
+}
+
+const sf::Texture *TextureAtlas_texture() {
+    return _atlasTexture;
+}
+
+void TextureAtlas_destroy() {
+    delete _atlasTexture;
+    _atlasTexture = NULL;
+
+    _atlasRegions.clear();
+    _packedRegions.clear();
+}
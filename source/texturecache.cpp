@@ -0,0 +1,284 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <map>
+#include "texturecache.h"
+#include "textureatlas.h"
+#include "embeddedartwork.h"
+
+///
+/// \brief The texture (and its users) in the cache
+///
+struct TextureCacheEntry {
+    ///
+    /// \brief The texture file name
+    ///
+    std::string filename;
+
+    ///
+    /// \brief The loaded texture, if the image is not in the atlas
+    ///
+    sf::Texture texture;
+
+    ///
+    /// \brief The atlas texture, or NULL if the image is not in the atlas
+    ///
+    const sf::Texture *atlasTexture;
+
+    ///
+    /// \brief The image region in the texture
+    ///
+    sf::IntRect region;
+
+    ///
+    /// \brief The no of SharedTexture that use this texture
+    ///
+    unsigned int refCount;
+
+    ///
+    /// \brief Flag to keep the texture even if refCount is 0
+    ///
+    bool isPinned;
+};
+
+///
+/// \brief The textures in the cache, indexed by their file name
+///
+static std::map<std::string, TextureCacheEntry *> _textureCache;
+
+///
+/// \brief Protect the cache. The textures can be shared by a game state 
+///        that's constructed in a worker thread.
+///
+static sf::Mutex _textureCacheMutex;
+
+//-----------------------------------------------------------------------------
+///
+/// \brief Find the texture in the cache, or load it
+///
+/// \param filename The texture file name
+///
+/// \return The texture in the cache
+///
+static TextureCacheEntry *TextureCache_find(const std::string &filename) {
+    std::map<std::string, TextureCacheEntry *>::iterator it = 
+        _textureCache.find(filename);
+
+    if (it != _textureCache.end()) {
+        return it->second;
+    }
+
+    TextureCacheEntry *entry = new TextureCacheEntry();
+    entry->filename = filename;
+    entry->refCount = 0;
+    entry->isPinned = false;
+    entry->atlasTexture = TextureAtlas_find(filename, &entry->region);
+
+    if (entry->atlasTexture == NULL) {
+        // Not in the atlas, it needs its own texture
+        sf::Image image;
+        if (EmbeddedArtwork_loadImage(filename, &image)) {
+            entry->texture.loadFromImage(image);
+        }
+        entry->region = sf::IntRect(sf::Vector2i(0, 0), 
+                                    sf::Vector2i(entry->texture.getSize()));
+    }
+
+    _textureCache[filename] = entry;
+
+    return entry;
+}
+
+///
+/// \brief Remove the texture from the cache if nobody needs it anymore
+///
+/// \param entry The texture in the cache
+///
+static void TextureCache_releaseIfUnused(TextureCacheEntry *entry) {
+    if ((entry->refCount > 0) || (entry->isPinned)) {
+        return;
+    }
+
+    _textureCache.erase(entry->filename);
+    delete entry;
+}
+
+///
+/// \brief Add a user to the texture
+///
+/// \param entry The texture in the cache, can be NULL
+///
+static void TextureCache_acquire(TextureCacheEntry *entry) {
+    if (entry != NULL) {
+        entry->refCount++;
+    }
+}
+
+///
+/// \brief Remove a user from the texture
+///
+/// \param entry The texture in the cache, can be NULL
+///
+static void TextureCache_release(TextureCacheEntry *entry) {
+    if (entry != NULL) {
+        entry->refCount--;
+        TextureCache_releaseIfUnused(entry);
+    }
+}
+
+//-----------------------------------------------------------------------------
+void TextureCache_pin(const std::string &filename) {
+    sf::Lock lock(_textureCacheMutex);
+
+    TextureCache_find(filename)->isPinned = true;
+}
+
+void TextureCache_unpin(const std::string &filename) {
+    sf::Lock lock(_textureCacheMutex);
+
+    std::map<std::string, TextureCacheEntry *>::iterator it = 
+        _textureCache.find(filename);
+
+    if (it != _textureCache.end()) {
+        it->second->isPinned = false;
+        TextureCache_releaseIfUnused(it->second);
+    }
+}
+
+void TextureCache_unpinAll() {
+    sf::Lock lock(_textureCacheMutex);
+
+    std::map<std::string, TextureCacheEntry *>::iterator it = 
+        _textureCache.begin();
+
+    while (it != _textureCache.end()) {
+        // Advance first, the entry may be erased from the cache
+        TextureCacheEntry *entry = it->second;
+        ++it;
+
+        entry->isPinned = false;
+        TextureCache_releaseIfUnused(entry);
+    }
+}
+
+unsigned int TextureCache_textureCount() {
+    sf::Lock lock(_textureCacheMutex);
+
+    return _textureCache.size();
+}
+
+unsigned int TextureCache_memoryUsage() {
+    sf::Lock lock(_textureCacheMutex);
+
+    unsigned int memoryUsage = 0;
+
+    // The atlas is counted once, no matter how many images use it
+    if (TextureAtlas_texture() != NULL) {
+        sf::Vector2u size = TextureAtlas_texture()->getSize();
+        memoryUsage += size.x * size.y * 4;
+    }
+
+    std::map<std::string, TextureCacheEntry *>::const_iterator it;
+    for (it = _textureCache.begin(); it != _textureCache.end(); ++it) {
+        if (it->second->atlasTexture == NULL) {
+            sf::Vector2u size = it->second->texture.getSize();
+            memoryUsage += size.x * size.y * 4;
+        }
+    }
+
+    return memoryUsage;
+}
+
+//-----------------------------------------------------------------------------
+SharedTexture::SharedTexture(const std::string &filename) :
+    _entry(NULL)
+{
+    sf::Lock lock(_textureCacheMutex);
+
+    if (!filename.empty()) {
+        _entry = TextureCache_find(filename);
+        TextureCache_acquire(_entry);
+    }
+}
+
+SharedTexture::SharedTexture(const SharedTexture &other) :
+    _entry(other._entry)
+{
+    sf::Lock lock(_textureCacheMutex);
+
+    TextureCache_acquire(_entry);
+}
+
+SharedTexture &SharedTexture::operator=(const SharedTexture &other) {
+    sf::Lock lock(_textureCacheMutex);
+
+    // Acquire first, so assigning to itself doesn't release the texture
+    TextureCache_acquire(other._entry);
+    TextureCache_release(_entry);
+
+    _entry = other._entry;
+
+    return *this;
+}
+
+SharedTexture::~SharedTexture() {
+    sf::Lock lock(_textureCacheMutex);
+
+    TextureCache_release(_entry);
+}
+
+const sf::Texture *SharedTexture::get() const {
+    if (_entry == NULL) {
+        return NULL;
+    }
+
+    if (_entry->atlasTexture != NULL) {
+        return _entry->atlasTexture;
+    }
+
+    return &_entry->texture;
+}
+
+sf::Vector2u SharedTexture::getSize() const {
+    if (_entry == NULL) {
+        return sf::Vector2u(0, 0);
+    }
+
+    return sf::Vector2u(_entry->region.width, _entry->region.height);
+}
+
+sf::Vector2u SharedTexture::getOffset() const {
+    if (_entry == NULL) {
+        return sf::Vector2u(0, 0);
+    }
+
+    return sf::Vector2u(_entry->region.left, _entry->region.top);
+}
+
+sf::IntRect SharedTexture::getRegion() const {
+    if (_entry == NULL) {
+        return sf::IntRect();
+    }
+
+    return _entry->region;
+}
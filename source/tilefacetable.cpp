@@ -0,0 +1,118 @@
+/*
+ * The MIT License (MIT)
+ * Copyright (c) 2013 Daniel Widyanto
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to 
+ * deal in the Software without restriction, including without limitation the 
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+ * sell copies of the Software, and to permit persons to whom the Software is 
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in 
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR 
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, 
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE 
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER 
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+ * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+ * IN THE SOFTWARE.
+ */
+
+#include <map>
+#include <utility>
+#include "tilefacetable.h"
+
+///
+/// \brief A size / position in pixel (x, y)
+///
+typedef std::pair<unsigned int, unsigned int> TileFaceTableVector;
+
+///
+/// \brief The key to find the face table ((tilemap size, tile size), 
+///        tilemap offset)
+///
+typedef std::pair<std::pair<TileFaceTableVector, TileFaceTableVector>,
+                  TileFaceTableVector> TileFaceTableKey;
+
+///
+/// \brief All face tables that have been created
+///
+static std::map<TileFaceTableKey, TileFaceTable *> _faceTables;
+
+///
+/// \brief Protect the face tables, the views can be constructed in a worker
+///        thread
+///
+static sf::Mutex _faceTablesMutex;
+
+//-----------------------------------------------------------------------------
+const TileFaceTable *TileFaceTable::get(sf::Vector2u tilemapSize, 
+                                        sf::Vector2u tileSize,
+                                        sf::Vector2u tilemapOffset) {
+    TileFaceTableKey key = std::make_pair(
+        std::make_pair(std::make_pair(tilemapSize.x,   tilemapSize.y),
+                       std::make_pair(tileSize.x,      tileSize.y)),
+        std::make_pair(tilemapOffset.x, tilemapOffset.y)
+    );
+
+    sf::Lock lock(_faceTablesMutex);
+
+    std::map<TileFaceTableKey, TileFaceTable *>::iterator it = 
+        _faceTables.find(key);
+
+    if (it != _faceTables.end()) {
+        return it->second;
+    }
+
+    TileFaceTable *table = 
+        new TileFaceTable(tilemapSize, tileSize, tilemapOffset);
+    _faceTables[key] = table;
+
+    return table;
+}
+
+TileFaceTable::TileFaceTable(sf::Vector2u tilemapSize, 
+                             sf::Vector2u tileSize,
+                             sf::Vector2u tilemapOffset) :
+    _faceCount(1)
+{
+    if ((tileSize.x == 0) || (tileSize.y == 0)) {
+        // No tile in the tilemap, provide a single empty face
+        _texCoords.resize(4, sf::Vector2f((float) tilemapOffset.x, 
+                                          (float) tilemapOffset.y));
+        return;
+    }
+
+    unsigned int columns = tilemapSize.x / tileSize.x;
+    unsigned int rows    = tilemapSize.y / tileSize.y;
+
+    // Keep at least one face, so texCoords() always has something to return
+    if (columns == 0) {
+        columns = 1;
+    }
+    if (rows == 0) {
+        rows = 1;
+    }
+
+    _faceCount = columns * rows;
+    _texCoords.resize(_faceCount * 4);
+
+    for (unsigned int face = 0; face < _faceCount; face++) {
+        // Find the face's column / row in the texture
+        float tu = (float) (face % columns);
+        float tv = (float) (face / columns);
+
+        // The tile's top-left corner in the texture
+        float left = (float) (tilemapOffset.x + (tu * tileSize.x));
+        float top  = (float) (tilemapOffset.y + (tv * tileSize.y));
+
+        _texCoords[(face * 4) + 0] = sf::Vector2f(left, top);
+        _texCoords[(face * 4) + 1] = sf::Vector2f(left + tileSize.x, top);
+        _texCoords[(face * 4) + 2] = 
+            sf::Vector2f(left + tileSize.x, top + tileSize.y);
+        _texCoords[(face * 4) + 3] = sf::Vector2f(left, top + tileSize.y);
+    }
+}
@@ -23,36 +23,24 @@
 
 #include "tileview.h"
 
-TileView::TileView(sf::Vector2u tilemapSize, sf::Vector2u tileSize) :
+TileView::TileView(sf::Vector2u tilemapSize, 
+                   sf::Vector2u tileSize,
+                   sf::Vector2u tilemapOffset) :
     _tileFace (0),
-    _tilemapSize(tilemapSize),
-    _tileSize (tileSize)
+    _tilePos(sf::Vector2f(0, 0)),
+    _faceTable(TileFaceTable::get(tilemapSize, tileSize, tilemapOffset)),
+    _tileSize (tileSize),
+    _isDirty(true)
 {
-    setPosition(sf::Vector2f(0, 0));
-
-    // Each tile requires 4 Vertex points
-    _vertex.resize(4);
 }
 
-void TileView::update(sf::Time elapsedTime) {
-    // Find the _tileValue column in the texture
-    float tu = (float) (_tileFace % (_tilemapSize.x / _tileSize.x));
-    // Find the _tileValue row in the texture
-    float tv = (float) (_tileFace / (_tilemapSize.x / _tileSize.x));
-
-    _vertex[0].texCoords = sf::Vector2f(
-        (tu       * _tileSize.x), (tv       * _tileSize.y)
-    );
-    _vertex[1].texCoords = sf::Vector2f(
-        ((tu + 1) * _tileSize.x), (tv       * _tileSize.y)
-    );
-    _vertex[2].texCoords = sf::Vector2f(
-        ((tu + 1) * _tileSize.x), ((tv + 1) * _tileSize.y)
-    );
-    _vertex[3].texCoords = sf::Vector2f(
-        (tu       * _tileSize.x), ((tv + 1) * _tileSize.y)
-    );
+void TileView::update(sf::Vertex *vertex) {
+    const sf::Vector2f *texCoords = _faceTable->texCoords(_tileFace);
 
+    vertex[0].texCoords = texCoords[0];
+    vertex[1].texCoords = texCoords[1];
+    vertex[2].texCoords = texCoords[2];
+    vertex[3].texCoords = texCoords[3];
 
     // Adjust the position for the tiles (in the screen)
     float leftColumn  = _tilePos.x - (_tileSize.x / 2);
@@ -60,8 +48,10 @@ void TileView::update(sf::Time elapsedTime) {
     float topRow      = _tilePos.y - (_tileSize.y / 2);
     float bottomRow   = _tilePos.y + _tileSize.y - (_tileSize.y / 2);
     
-    _vertex[0].position = sf::Vector2f( leftColumn,    topRow);
-    _vertex[1].position = sf::Vector2f(rightColumn,    topRow);
-    _vertex[2].position = sf::Vector2f(rightColumn, bottomRow);
-    _vertex[3].position = sf::Vector2f( leftColumn, bottomRow);
+    vertex[0].position = sf::Vector2f( leftColumn,    topRow);
+    vertex[1].position = sf::Vector2f(rightColumn,    topRow);
+    vertex[2].position = sf::Vector2f(rightColumn, bottomRow);
+    vertex[3].position = sf::Vector2f( leftColumn, bottomRow);
+
+    _isDirty = false;
 }
@@ -0,0 +1,269 @@
+#!/usr/bin/env python
+#
+# The MIT License (MIT)
+# Copyright (c) 2013 Daniel Widyanto
+#
+# Permission is hereby granted, free of charge, to any person obtaining a copy
+# of this software and associated documentation files (the "Software"), to 
+# deal in the Software without restriction, including without limitation the 
+# rights to use, copy, modify, merge, publish, distribute, sublicense, and/or 
+# sell copies of the Software, and to permit persons to whom the Software is
+# furnished to do so, subject to the following conditions:
+#
+# The above copyright notice and this permission notice shall be included in 
+# all copies or substantial portions of the Software.
+#
+# THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+# IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+# FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+# AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+# LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING 
+# FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
+# IN THE SOFTWARE.
+#
+# Build step: decode the artwork PNGs, and generate a C++ source file with 
+# their LZ4-compressed RGBA pixels (see include/embeddedartwork.h).
+#
+# Usage: python tools/embedartwork.py [artwork dir] [output file]
+#
+# Only the standard library is used, so the build doesn't need any image
+# package. Non-interlaced 8-bit greyscale, RGB, palette and RGBA PNGs are 
+# supported.
+#
+
+import os
+import struct
+import sys
+import zlib
+
+PNG_SIGNATURE = b'\x89PNG\r\n\x1a\n'
+
+# LZ4 block format limits: the minimum match length, the last bytes that are
+# always literals, the last position a match may start from the end, and the
+# maximum match offset
+LZ4_MIN_MATCH    = 4
+LZ4_LAST_LITERAL = 5
+LZ4_MATCH_LIMIT  = 12
+LZ4_MAX_OFFSET   = 65535
+
+# The no of array values per line in the generated source
+VALUES_PER_LINE = 18
+
+
+def paeth(a, b, c):
+    p  = a + b - c
+    pa = abs(p - a)
+    pb = abs(p - b)
+    pc = abs(p - c)
+
+    if (pa <= pb) and (pa <= pc):
+        return a
+    if pb <= pc:
+        return b
+    return c
+
+
+def decode_png(filename):
+    """Decode the PNG file. Return (width, height, RGBA bytes)."""
+    with open(filename, 'rb') as f:
+        data = f.read()
+
+    if data[:8] != PNG_SIGNATURE:
+        raise ValueError('%s: not a PNG file' % filename)
+
+    pos      = 8
+    idat     = b''
+    palette  = None
+    alphas   = None
+    header   = None
+
+    while pos < len(data):
+        length, = struct.unpack('>I', data[pos:pos + 4])
+        kind    = data[pos + 4:pos + 8]
+        chunk   = data[pos + 8:pos + 8 + length]
+        pos     = pos + 12 + length
+
+        if kind == b'IHDR':
+            header = struct.unpack('>IIBBBBB', chunk)
+        elif kind == b'PLTE':
+            palette = chunk
+        elif kind == b'tRNS':
+            alphas = chunk
+        elif kind == b'IDAT':
+            idat += chunk
+        elif kind == b'IEND':
+            break
+
+    width, height, depth, colorType, _, _, interlace = header
+    if (depth != 8) or (interlace != 0):
+        raise ValueError('%s: unsupported PNG format' % filename)
+
+    channels = { 0: 1, 2: 3, 3: 1, 4: 2, 6: 4 }[colorType]
+    stride   = width * channels
+    raw      = bytearray(zlib.decompress(idat))
+    pixels   = bytearray(height * stride)
+    previous = bytearray(stride)
+
+    # Undo the scanline filters
+    for y in range(height):
+        kind = raw[y * (stride + 1)]
+        line = raw[y * (stride + 1) + 1:(y + 1) * (stride + 1)]
+
+        for x in range(stride):
+            a = line[x - channels] if x >= channels else 0
+            b = previous[x]
+            c = previous[x - channels] if x >= channels else 0
+
+            if kind == 1:
+                line[x] = (line[x] + a) & 0xFF
+            elif kind == 2:
+                line[x] = (line[x] + b) & 0xFF
+            elif kind == 3:
+                line[x] = (line[x] + ((a + b) >> 1)) & 0xFF
+            elif kind == 4:
+                line[x] = (line[x] + paeth(a, b, c)) & 0xFF
+
+        pixels[y * stride:(y + 1) * stride] = line
+        previous = line
+
+    # Convert to RGBA
+    rgba = bytearray(width * height * 4)
+
+    for i in range(width * height):
+        p = pixels[i * channels:(i + 1) * channels]
+
+        if colorType == 0:
+            rgba[i * 4:i * 4 + 4] = bytearray((p[0], p[0], p[0], 255))
+        elif colorType == 2:
+            rgba[i * 4:i * 4 + 4] = bytearray((p[0], p[1], p[2], 255))
+        elif colorType == 3:
+            alpha = alphas[p[0]] if (alphas and p[0] < len(alphas)) else 255
+            rgba[i * 4:i * 4 + 4] = bytearray(
+                (palette[p[0] * 3], palette[p[0] * 3 + 1], 
+                 palette[p[0] * 3 + 2], alpha))
+        elif colorType == 4:
+            rgba[i * 4:i * 4 + 4] = bytearray((p[0], p[0], p[0], p[1]))
+        else:
+            rgba[i * 4:i * 4 + 4] = p
+
+    return width, height, bytes(rgba)
+
+
+def lz4_write_length(output, length):
+    while length >= 255:
+        output.append(255)
+        length -= 255
+    output.append(length)
+
+
+def lz4_write_sequence(output, literals, offset, matchLength):
+    """Write a sequence: the token, the literals and, unless it's the last
+    sequence, the match offset and length."""
+    literalLength = len(literals)
+    matchCode     = matchLength - LZ4_MIN_MATCH if offset else 0
+
+    output.append((min(literalLength, 15) << 4) | min(matchCode, 15))
+    if literalLength >= 15:
+        lz4_write_length(output, literalLength - 15)
+    output += literals
+
+    if offset:
+        output += struct.pack('<H', offset)
+        if matchCode >= 15:
+            lz4_write_length(output, matchCode - 15)
+
+
+def lz4_compress(data):
+    """Compress the data into an LZ4 block (greedy, with a single candidate
+    per 4-byte sequence)."""
+    output = bytearray()
+    table  = {}
+    anchor = 0
+    i      = 0
+    limit  = len(data) - LZ4_MATCH_LIMIT
+
+    while i < limit:
+        key       = data[i:i + LZ4_MIN_MATCH]
+        candidate = table.get(key)
+        table[key] = i
+
+        if (candidate is None) or (i - candidate > LZ4_MAX_OFFSET):
+            i += 1
+            continue
+
+        # Extend the match, keeping the last bytes as literals
+        length   = LZ4_MIN_MATCH
+        maxMatch = len(data) - LZ4_LAST_LITERAL - i
+        while ((length < maxMatch) and 
+               (data[candidate + length] == data[i + length])):
+            length += 1
+
+        lz4_write_sequence(output, data[anchor:i], i - candidate, length)
+        i     += length
+        anchor = i
+
+    lz4_write_sequence(output, data[anchor:], 0, 0)
+    return bytes(output)
+
+
+def symbol_name(filename):
+    name = os.path.splitext(os.path.basename(filename))[0]
+    return '_' + ''.join(c if c.isalnum() else '_' for c in name)
+
+
+def main():
+    artworkDir = sys.argv[1] if len(sys.argv) > 1 else 'artwork'
+    outputFile = (sys.argv[2] if len(sys.argv) > 2 
+                  else os.path.join('source', 'embeddedartworkdata.cpp'))
+
+    filenames = sorted(f for f in os.listdir(artworkDir) 
+                       if f.lower().endswith('.png'))
+
+    # Skip it when the output is newer than the artwork and this script
+    if os.path.exists(outputFile):
+        sources = [os.path.join(artworkDir, f) for f in filenames]
+        sources.append(os.path.abspath(__file__))
+        if all(os.path.getmtime(f) <= os.path.getmtime(outputFile) 
+               for f in sources):
+            return
+
+    lines = [
+        '/*',
+        ' * Generated by tools/embedartwork.py. Do not edit.',
+        ' */',
+        '',
+        '#include "embeddedartwork.h"',
+        ''
+    ]
+    entries = []
+
+    for filename in filenames:
+        width, height, rgba = decode_png(os.path.join(artworkDir, filename))
+        data   = lz4_compress(rgba)
+        symbol = symbol_name(filename)
+
+        lines.append('static const unsigned char %s[] = {' % symbol)
+        for i in range(0, len(data), VALUES_PER_LINE):
+            chunk = bytearray(data[i:i + VALUES_PER_LINE])
+            lines.append(','.join('%d' % b for b in chunk) + ',')
+        lines.append('};')
+        lines.append('')
+
+        # The artwork is looked up with the same path as the game uses
+        entries.append('    { "artwork/%s", %d, %d, %s, sizeof(%s) },' % 
+                       (filename, width, height, symbol, symbol))
+
+    lines.append('const EmbeddedArtworkImage _embeddedArtwork[] = {')
+    lines += entries
+    lines.append('};')
+    lines.append('')
+    lines.append('const unsigned int _embeddedArtworkCount = %d;' % 
+                 len(entries))
+    lines.append('')
+
+    with open(outputFile, 'w') as f:
+        f.write('\n'.join(lines))
+
+
+if __name__ == '__main__':
+    main()